@@ -0,0 +1,59 @@
+﻿/*
+ * Tencent is pleased to support the open source community by making xLua available.
+ * Copyright (C) 2016 THL A29 Limited, a Tencent company. All rights reserved.
+ * Licensed under the MIT License (the "License"); you may not use this file except in compliance with the License. You may obtain a copy of the License at
+ * http://opensource.org/licenses/MIT
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the specific language governing permissions and limitations under the License.
+*/
+
+#if USE_UNI_LUA
+using LuaAPI = UniLua.Lua;
+using RealStatePtr = UniLua.ILuaState;
+using LuaCSFunction = UniLua.CSharpFunctionDelegate;
+#else
+using LuaAPI = XLua.LuaDLL.Lua;
+using RealStatePtr = System.IntPtr;
+using LuaCSFunction = XLua.LuaDLL.lua_CSFunction;
+#endif
+
+using System;
+
+namespace XLua
+{
+    internal abstract class ArrayAccessor
+    {
+        public abstract void Get(RealStatePtr L, object array, int index);
+
+        public abstract bool TrySet(RealStatePtr L, object array, int array_idx, int obj_idx);
+    }
+
+    // typed element access for T[], so indexing a known array type neither walks a type chain nor boxes
+    internal class ArrayAccessor<T> : ArrayAccessor
+    {
+        Action<RealStatePtr, T> push;
+        Func<RealStatePtr, int, T> get;
+        Func<RealStatePtr, int, bool> check;
+
+        public ArrayAccessor(Action<RealStatePtr, T> push, Func<RealStatePtr, int, T> get, Func<RealStatePtr, int, bool> check)
+        {
+            this.push = push;
+            this.get = get;
+            this.check = check;
+        }
+
+        public override void Get(RealStatePtr L, object array, int index)
+        {
+            push(L, ((T[])array)[index]);
+        }
+
+        public override bool TrySet(RealStatePtr L, object array, int array_idx, int obj_idx)
+        {
+            if (check != null && !check(L, obj_idx))
+            {
+                return false;
+            }
+            ((T[])array)[array_idx] = get(L, obj_idx);
+            return true;
+        }
+    }
+}
@@ -25,6 +25,8 @@ using LuaCSFunction = XLua.LuaDLL.lua_CSFunction;
 
 namespace XLua
 {
+    public delegate object MethodInvoker(object target, object[] args);
+
     public class CodeEmit
     {
         private ModuleBuilder codeEmitModule = null;
@@ -1912,6 +1914,133 @@ namespace XLua
 
             return methodBuilder;
         }
+
+        // strongly typed replacement for MethodBase.Invoke, return null if the method can not be compiled
+        public static MethodInvoker EmitMethodInvoker(MethodBase method)
+        {
+            if (method.ContainsGenericParameters || method.DeclaringType == null || method.DeclaringType.ContainsGenericParameters)
+            {
+                return null;
+            }
+            MethodInfo methodInfo = method as MethodInfo;
+            ConstructorInfo ctorInfo = method as ConstructorInfo;
+            if ((methodInfo == null && ctorInfo == null) || (ctorInfo != null && ctorInfo.IsStatic)
+                || (methodInfo != null && (methodInfo.ReturnType.IsByRef || methodInfo.ReturnType.IsPointer)))
+            {
+                return null;
+            }
+            var paramInfos = method.GetParameters();
+            foreach (var paramInfo in paramInfos)
+            {
+                Type paramType = paramInfo.ParameterType.IsByRef ? paramInfo.ParameterType.GetElementType() : paramInfo.ParameterType;
+                if (paramType.IsPointer || paramType.IsByRef)
+                {
+                    return null;
+                }
+            }
+
+            DynamicMethod dynamicMethod = new DynamicMethod("__XLua_Invoke_" + method.Name, typeof(object),
+                new Type[] { typeof(object), typeof(object[]) }, typeof(CodeEmit).Module, true);
+            ILGenerator il = dynamicMethod.GetILGenerator();
+
+            Type declaringType = method.DeclaringType;
+            if (methodInfo != null && !methodInfo.IsStatic)
+            {
+                il.Emit(OpCodes.Ldarg_0);
+                il.Emit(declaringType.IsValueType ? OpCodes.Unbox : OpCodes.Castclass, declaringType);
+            }
+
+            LocalBuilder[] refLocals = new LocalBuilder[paramInfos.Length];
+            for (int i = 0; i < paramInfos.Length; i++)
+            {
+                Type paramType = paramInfos[i].ParameterType;
+                if (paramType.IsByRef)
+                {
+                    Type elementType = paramType.GetElementType();
+                    refLocals[i] = il.DeclareLocal(elementType);
+                    Label skipInit = il.DefineLabel();
+                    il.Emit(OpCodes.Ldarg_1);
+                    il.Emit(OpCodes.Ldc_I4, i);
+                    il.Emit(OpCodes.Ldelem_Ref);
+                    il.Emit(OpCodes.Brfalse, skipInit);
+                    il.Emit(OpCodes.Ldarg_1);
+                    il.Emit(OpCodes.Ldc_I4, i);
+                    il.Emit(OpCodes.Ldelem_Ref);
+                    il.Emit(OpCodes.Unbox_Any, elementType);
+                    il.Emit(OpCodes.Stloc, refLocals[i]);
+                    il.MarkLabel(skipInit);
+                    il.Emit(OpCodes.Ldloca, refLocals[i]);
+                }
+                else if (paramType.IsValueType && Nullable.GetUnderlyingType(paramType) == null)
+                {
+                    // null (an optional "= default" parameter) becomes default(T), as reflection does
+                    LocalBuilder defaultValue = il.DeclareLocal(paramType);
+                    Label notNull = il.DefineLabel();
+                    Label loaded = il.DefineLabel();
+                    il.Emit(OpCodes.Ldarg_1);
+                    il.Emit(OpCodes.Ldc_I4, i);
+                    il.Emit(OpCodes.Ldelem_Ref);
+                    il.Emit(OpCodes.Dup);
+                    il.Emit(OpCodes.Brtrue, notNull);
+                    il.Emit(OpCodes.Pop);
+                    il.Emit(OpCodes.Ldloca, defaultValue);
+                    il.Emit(OpCodes.Initobj, paramType);
+                    il.Emit(OpCodes.Ldloc, defaultValue);
+                    il.Emit(OpCodes.Br, loaded);
+                    il.MarkLabel(notNull);
+                    il.Emit(OpCodes.Unbox_Any, paramType);
+                    il.MarkLabel(loaded);
+                }
+                else
+                {
+                    il.Emit(OpCodes.Ldarg_1);
+                    il.Emit(OpCodes.Ldc_I4, i);
+                    il.Emit(OpCodes.Ldelem_Ref);
+                    il.Emit(OpCodes.Unbox_Any, paramType);
+                }
+            }
+
+            Type returnType;
+            if (ctorInfo != null)
+            {
+                il.Emit(OpCodes.Newobj, ctorInfo);
+                returnType = declaringType;
+            }
+            else
+            {
+                il.Emit((methodInfo.IsStatic || declaringType.IsValueType) ? OpCodes.Call : OpCodes.Callvirt, methodInfo);
+                returnType = methodInfo.ReturnType;
+            }
+
+            if (returnType == typeof(void))
+            {
+                il.Emit(OpCodes.Ldnull);
+            }
+            else if (returnType.IsValueType)
+            {
+                il.Emit(OpCodes.Box, returnType);
+            }
+
+            for (int i = 0; i < paramInfos.Length; i++)
+            {
+                if (refLocals[i] != null)
+                {
+                    Type elementType = refLocals[i].LocalType;
+                    il.Emit(OpCodes.Ldarg_1);
+                    il.Emit(OpCodes.Ldc_I4, i);
+                    il.Emit(OpCodes.Ldloc, refLocals[i]);
+                    if (elementType.IsValueType)
+                    {
+                        il.Emit(OpCodes.Box, elementType);
+                    }
+                    il.Emit(OpCodes.Stelem_Ref);
+                }
+            }
+
+            il.Emit(OpCodes.Ret);
+
+            return (MethodInvoker)dynamicMethod.CreateDelegate(typeof(MethodInvoker));
+        }
     }
 }
 
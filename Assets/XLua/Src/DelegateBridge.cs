@@ -22,6 +22,19 @@ using System.Runtime.InteropServices;
 
 namespace XLua
 {
+    // counters of LuaEnv.GetDelegateBridgeStats, sample them per frame to get the bridge creation rate
+    public struct DelegateBridgeStats
+    {
+        // bridges created for a lua function which had no live bridge
+        public long Created;
+        // casts served by the live bridge of the same lua function
+        public long Reused;
+        // delegates generated for a bridge, one per delegate type it is cast to
+        public long DelegatesCreated;
+        // bridges released by LuaEnv.Tick or Dispose
+        public long Released;
+    }
+
     public abstract class DelegateBridgeBase : LuaBase
     {
         private Type firstKey = null;
@@ -146,7 +159,11 @@ namespace XLua
 
         public void InvokeSessionStart()
         {
+#if THREAD_AFFINITY && !THREAD_SAFE
+            luaEnv.CheckOwnerThread();
+#else
             System.Threading.Monitor.Enter(luaEnv.luaEnvLock);
+#endif
             var L = luaEnv.L;
             _stack.Push(_oldTop);
             _oldTop = LuaAPI.lua_gettop(L);
@@ -161,7 +178,9 @@ namespace XLua
             {
                 var lastOldTop = _oldTop;
                 _oldTop = _stack.Pop();
+#if !THREAD_AFFINITY || THREAD_SAFE
                 System.Threading.Monitor.Exit(luaEnv.luaEnvLock);
+#endif
                 luaEnv.ThrowExceptionFromError(lastOldTop);
             }
         }
@@ -170,7 +189,9 @@ namespace XLua
         {
             LuaAPI.lua_settop(luaEnv.L, _oldTop);
             _oldTop = _stack.Pop();
+#if !THREAD_AFFINITY || THREAD_SAFE
             System.Threading.Monitor.Exit(luaEnv.luaEnvLock);
+#endif
         }
 
         public TResult InvokeSessionEndWithResult<TResult>()
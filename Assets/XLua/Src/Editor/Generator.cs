@@ -106,7 +106,41 @@ namespace CSObjectWrapEditor
 
     public static class Generator
     {
-        static LuaEnv luaenv = new LuaEnv();
+        // wrap generation renders templates on worker threads, each worker has its own env and template cache.
+        // a [ThreadStatic] initializer only runs on the thread running the type initializer, so the env is created
+        // lazily by the thread using it, which also keeps THREAD_AFFINITY happy
+        [ThreadStatic]
+        static LuaEnv threadEnv;
+        static LuaEnv luaenv
+        {
+            get
+            {
+                if (threadEnv == null)
+                {
+                    threadEnv = new LuaEnv();
+                    threadEnv.AddLoader(loadTemplateCommon);
+                }
+                return threadEnv;
+            }
+        }
+
+        // disposes the env and templates of the calling thread
+        static void disposeThreadEnv()
+        {
+            if (templateCache != null)
+            {
+                foreach (var template in templateCache.Values)
+                {
+                    template.Dispose();
+                }
+                templateCache = null;
+            }
+            if (threadEnv != null)
+            {
+                threadEnv.Dispose();
+                threadEnv = null;
+            }
+        }
         static List<string> OpMethodNames = new List<string>() { "op_Addition", "op_Subtraction", "op_Multiply", "op_Division", "op_Equality", "op_UnaryNegation", "op_LessThan", "op_LessThanOrEqual", "op_Modulus",
             "op_BitwiseAnd", "op_BitwiseOr", "op_ExclusiveOr", "op_OnesComplement", "op_LeftShift", "op_RightShift"};
         private static XLuaTemplates templateRef;
@@ -140,18 +174,70 @@ namespace CSObjectWrapEditor
                 PackUnpack = { name = template_ref.PackUnpack.name, text = template_ref.PackUnpack.text },
                 TemplateCommon = { name = template_ref.TemplateCommon.name, text = template_ref.TemplateCommon.text },
             };
+            XLua.TemplateEngine.LuaTemplate.BytecodeCachePath = "Library/XLuaTemplateCache";
 #endif
-            luaenv.AddLoader((ref string filepath) =>
+        }
+
+        static byte[] loadTemplateCommon(ref string filepath)
+        {
+            if (filepath == "TemplateCommon")
             {
-                if (filepath == "TemplateCommon")
-                {
-                    return Encoding.UTF8.GetBytes(templateRef.TemplateCommon.text);
-                }
-                else
-                {
-                    return null;
-                }
-            });
+                return Encoding.UTF8.GetBytes(templateRef.TemplateCommon.text);
+            }
+            else
+            {
+                return null;
+            }
+        }
+
+        static List<Type> genPushAndUpdateTypes;
+        static List<Type> xluaClasses;
+
+        static void initTemplateEnv(LuaEnv env)
+        {
+            env.DoString("require 'TemplateCommon'");
+#if XLUA_GENERAL
+            env.Global.Set("IsExtensionMethod", new Func<MethodInfo, bool>(IsExtensionMethod));
+            env.Global.Set("IsDelegate", new Func<Type, bool>(IsDelegate));
+#endif
+            var gen_push_types_setter = env.Global.Get<LuaFunction>("SetGenPushAndUpdateTypes");
+            gen_push_types_setter.Call(genPushAndUpdateTypes);
+            gen_push_types_setter.Dispose();
+            var xlua_classes_setter = env.Global.Get<LuaFunction>("SetXLuaClasses");
+            xlua_classes_setter.Call(xluaClasses);
+            xlua_classes_setter.Dispose();
+        }
+
+        static List<KeyValuePair<string, double>> phaseTimes = new List<KeyValuePair<string, double>>();
+
+        static void recordPhase(string phase, System.Diagnostics.Stopwatch watch)
+        {
+            phaseTimes.Add(new KeyValuePair<string, double>(phase, watch.Elapsed.TotalMilliseconds));
+            watch.Reset();
+            watch.Start();
+        }
+
+        static void timePhase(string phase, Action action)
+        {
+            var watch = System.Diagnostics.Stopwatch.StartNew();
+            action();
+            recordPhase(phase, watch);
+        }
+
+        static void logPhaseTimes(DateTime start)
+        {
+            StringBuilder sb = new StringBuilder();
+            sb.Append("finished! use " + (DateTime.Now - start).TotalMilliseconds + " ms");
+            foreach (var phase in phaseTimes)
+            {
+                sb.Append("\n    " + phase.Key + ": " + phase.Value + " ms");
+            }
+            phaseTimes.Clear();
+#if XLUA_GENERAL
+            Console.WriteLine(sb.ToString());
+#else
+            Debug.Log(sb.ToString());
+#endif
         }
 
         static bool IsOverride(MethodBase method)
@@ -571,11 +657,26 @@ namespace CSObjectWrapEditor
             return false;
         }
 
-        static Dictionary<string, LuaFunction> templateCache = new Dictionary<string, LuaFunction>();
-        static void GenOne(Type type, Action<Type, LuaTable> type_info_getter, XLuaTemplate templateAsset, StreamWriter textWriter)
+        [ThreadStatic]
+        static Dictionary<string, LuaFunction> templateCache;
+        static void GenOne(Type type, Action<Type, LuaTable> type_info_getter, XLuaTemplate templateAsset, TextWriter textWriter)
+        {
+            string genCode = renderOne(type, type_info_getter, templateAsset);
+            if (genCode != null)
+            {
+                textWriter.Write(genCode);
+                textWriter.Flush();
+            }
+        }
+
+        static string renderOne(Type type, Action<Type, LuaTable> type_info_getter, XLuaTemplate templateAsset)
         {
-            if (isObsolete(type)) return;
+            if (isObsolete(type)) return null;
             LuaFunction template;
+            if (templateCache == null)
+            {
+                templateCache = new Dictionary<string, LuaFunction>();
+            }
             if (!templateCache.TryGetValue(templateAsset.name, out template))
             {
                 template = XLua.TemplateEngine.LuaTemplate.Compile(luaenv, templateAsset.text);
@@ -592,10 +693,7 @@ namespace CSObjectWrapEditor
 
             try
             {
-                string genCode = XLua.TemplateEngine.LuaTemplate.Execute(template, type_info);
-                //string filePath = save_path + type.ToString().Replace("+", "").Replace(".", "").Replace("`", "").Replace("&", "").Replace("[", "").Replace("]", "").Replace(",", "") + file_suffix + ".cs";
-                textWriter.Write(genCode);
-                textWriter.Flush();
+                return XLua.TemplateEngine.LuaTemplate.Execute(template, type_info);
             }
             catch (Exception e)
             {
@@ -604,6 +702,7 @@ namespace CSObjectWrapEditor
 #else
                 Debug.LogError("gen wrap file fail! err=" + e.Message + ", stack=" + e.StackTrace);
 #endif
+                return null;
             }
             finally
             {
@@ -611,10 +710,268 @@ namespace CSObjectWrapEditor
             }
         }
 
+        class GenTask
+        {
+            public Type Type;
+            public string FilePath;
+            public XLuaTemplate Template;
+            public Action<Type, LuaTable> TypeInfoGetter;
+            public string Code;
+            public string Hash;
+        }
+
+        // incremental generation: signature hash of every file generated by the last run,
+        // a per type file whose hash is unchanged is neither rendered nor written
+        const string MANIFEST_FILE_NAME = ".xlua_gen_manifest";
+        static Dictionary<string, string> lastManifest = new Dictionary<string, string>();
+        static Dictionary<string, string> manifest = new Dictionary<string, string>();
+        static string configSignature = "";
+        // bump whenever a change of the generator code itself changes what it generates, the templates are hashed already
+        const int GENERATOR_VERSION = 2;
+        static Dictionary<string, string> templateHashes = new Dictionary<string, string>();
+
+        static string manifestKey(string filePath)
+        {
+            if (!filePath.StartsWith(GeneratorConfig.common_path)) return null;
+            string key = filePath.Substring(GeneratorConfig.common_path.Length);
+            return key.IndexOfAny(new char[] { '/', '\\' }) == -1 ? key : null;
+        }
+
+        static void loadManifest()
+        {
+            lastManifest.Clear();
+            manifest.Clear();
+            templateHashes.Clear();
+            string manifestPath = GeneratorConfig.common_path + MANIFEST_FILE_NAME;
+            if (File.Exists(manifestPath))
+            {
+                foreach (var line in File.ReadAllLines(manifestPath))
+                {
+                    int sep = line.IndexOf('\t');
+                    if (sep > 0)
+                    {
+                        lastManifest[line.Substring(0, sep)] = line.Substring(sep + 1);
+                    }
+                }
+            }
+            configSignature = getConfigSignature();
+        }
+
+        // files generated last time but not this time are deleted
+        static void saveManifest()
+        {
+            foreach (var key in lastManifest.Keys)
+            {
+                if (!manifest.ContainsKey(key))
+                {
+                    string filePath = GeneratorConfig.common_path + key;
+                    if (File.Exists(filePath))
+                    {
+                        File.Delete(filePath);
+                    }
+                    if (File.Exists(filePath + ".meta"))
+                    {
+                        File.Delete(filePath + ".meta");
+                    }
+                }
+            }
+            File.WriteAllLines(GeneratorConfig.common_path + MANIFEST_FILE_NAME,
+                manifest.OrderBy(kv => kv.Key, StringComparer.Ordinal).Select(kv => kv.Key + "\t" + kv.Value).ToArray());
+            lastManifest.Clear();
+            manifest.Clear();
+        }
+
+        static bool isUpToDate(string filePath, string hash)
+        {
+            string key = manifestKey(filePath);
+            string lastHash;
+            if (key != null && lastManifest.TryGetValue(key, out lastHash) && lastHash == hash && File.Exists(filePath))
+            {
+                manifest[key] = hash;
+                return true;
+            }
+            return false;
+        }
+
+        // leave the file untouched if the content is the same, so unity will not recompile it
+        static void writeGenFile(string filePath, string code, string hash = "")
+        {
+            string key = manifestKey(filePath);
+            if (key != null)
+            {
+                manifest[key] = hash;
+            }
+            if (File.Exists(filePath) && File.ReadAllText(filePath, Encoding.UTF8) == code)
+            {
+                return;
+            }
+            StreamWriter textWriter = new StreamWriter(filePath, false, Encoding.UTF8);
+            textWriter.Write(code);
+            textWriter.Close();
+        }
+
+        static string md5(string str)
+        {
+            using (var hasher = System.Security.Cryptography.MD5.Create())
+            {
+                return BitConverter.ToString(hasher.ComputeHash(Encoding.UTF8.GetBytes(str))).Replace("-", "");
+            }
+        }
+
+        static string getConfigSignature()
+        {
+            StringBuilder sb = new StringBuilder();
+            Action<string, IEnumerable<string>> append = (name, items) =>
+            {
+                sb.Append(name);
+                foreach (var item in items.OrderBy(item => item, StringComparer.Ordinal))
+                {
+                    sb.Append('|').Append(item);
+                }
+                sb.Append('\n');
+            };
+            append("LuaCallCSharp", LuaCallCSharp.Select(t => t.ToString()));
+            append("CSharpCallLua", CSharpCallLua.Select(t => t.ToString()));
+            append("GCOptimizeList", GCOptimizeList.Select(t => t.ToString()));
+            append("ReflectionUse", ReflectionUse.Select(t => t.ToString()));
+            append("BlackList", BlackList.Select(l => string.Join(",", l.ToArray())));
+            append("AdditionalProperties", AdditionalProperties.Select(kv => kv.Key + ":" + string.Join(",", kv.Value.ToArray())));
+            append("DoNotGen", DoNotGen.Select(kv => kv.Key + ":" + string.Join(",", kv.Value.ToArray())));
+            append("OptimizeCfg", OptimizeCfg.Select(kv => kv.Key + ":" + kv.Value));
+            append("GenPushAndUpdateTypes", genPushAndUpdateTypes.Select(t => t.ToString()));
+            append("XLuaClasses", xluaClasses.Select(t => t.ToString()));
+            // every template requires TemplateCommon, so it is part of every signature
+            append("TemplateCommon", new string[] { md5(templateRef.TemplateCommon.text) });
+            return sb.ToString();
+        }
+
+        // member.ToString() prints out and ref alike and leaves out defaults and params, which all change the wrapper
+        static string parameterSignature(ParameterInfo parameter)
+        {
+            return parameter.ParameterType + (parameter.IsOut ? " out" : "") + (parameter.IsIn ? " in" : "")
+                + (parameter.IsOptional ? " optional=" + parameter.DefaultValue : "")
+                + (parameter.IsDefined(typeof(ParamArrayAttribute), false) ? " params" : "");
+        }
+
+        internal static string memberSignature(MemberInfo member)
+        {
+            var field = member as FieldInfo;
+            var method = member as MethodBase;
+            return member.MemberType + " " + member + " " + (field != null ? field.Attributes.ToString() : "")
+                + (method != null ? method.Attributes.ToString() : "") + " "
+                + string.Join(",", CustomAttributeData.GetCustomAttributes(member).Select(a => a.ToString()).ToArray())
+                + (method != null ? " (" + string.Join(",", method.GetParameters().Select(p => parameterSignature(p)).ToArray()) + ")" : "");
+        }
+
+        // members, attributes and applicable extension methods of the type, together with the template, the gen config
+        // and the generator version
+        static string signatureHash(GenTask task)
+        {
+            string templateHash;
+            if (!templateHashes.TryGetValue(task.Template.name, out templateHash))
+            {
+                templateHash = md5(task.Template.text);
+                templateHashes[task.Template.name] = templateHash;
+            }
+            var type = task.Type;
+            var members = type.GetMembers(BindingFlags.Public | BindingFlags.NonPublic | BindingFlags.Instance | BindingFlags.Static)
+                .Select(member => memberSignature(member));
+            var extension_methods = type.IsInterface ? Enumerable.Empty<string>()
+                : GetExtensionMethods(type).Select(method => method.DeclaringType + " " + memberSignature(method));
+            return md5(GENERATOR_VERSION + "\n" + configSignature + templateHash + "\n" + type.AssemblyQualifiedName + "\n" + type.BaseType + "\n"
+                + string.Join(",", CustomAttributeData.GetCustomAttributes(type).Select(a => a.ToString()).ToArray()) + "\n"
+                + string.Join("\n", members.Concat(extension_methods).OrderBy(s => s, StringComparer.Ordinal).ToArray()));
+        }
+
+        //0 for one thread per processor
+        public static int GenThreadCount = 0;
+        const int MIN_TASKS_PER_THREAD = 16;
+
+        // render on worker threads, write the files in task order on the calling thread
+        static void runGenTasks(List<GenTask> allTasks, string phase)
+        {
+            var watch = System.Diagnostics.Stopwatch.StartNew();
+            var tasks = new List<GenTask>();
+            foreach (var task in allTasks)
+            {
+                task.Hash = signatureHash(task);
+                if (!isUpToDate(task.FilePath, task.Hash))
+                {
+                    tasks.Add(task);
+                }
+            }
+            recordPhase(phase + " check(" + (allTasks.Count - tasks.Count) + " of " + allTasks.Count + " unchanged)", watch);
+
+            int threadCount = Math.Min(GenThreadCount > 0 ? GenThreadCount : Environment.ProcessorCount, tasks.Count / MIN_TASKS_PER_THREAD);
+            if (threadCount <= 1)
+            {
+                foreach (var task in tasks)
+                {
+                    task.Code = renderOne(task.Type, task.TypeInfoGetter, task.Template);
+                }
+            }
+            else
+            {
+                GetExtensionMethods(typeof(object)); // fill the lazy cache before going wide
+
+                // every worker creates, uses and disposes its env on its own thread
+                var threads = new System.Threading.Thread[threadCount];
+                Exception workerException = null;
+                int nextTask = -1;
+                for (int i = 0; i < threadCount; i++)
+                {
+                    threads[i] = new System.Threading.Thread(() =>
+                    {
+                        try
+                        {
+                            initTemplateEnv(luaenv);
+                            int taskIndex;
+                            while ((taskIndex = System.Threading.Interlocked.Increment(ref nextTask)) < tasks.Count)
+                            {
+                                var task = tasks[taskIndex];
+                                task.Code = renderOne(task.Type, task.TypeInfoGetter, task.Template);
+                            }
+                        }
+                        catch (Exception e)
+                        {
+                            workerException = e;
+                        }
+                        finally
+                        {
+                            try
+                            {
+                                disposeThreadEnv();
+                            }
+                            catch (Exception e)
+                            {
+                                workerException = e;
+                            }
+                        }
+                    });
+                    threads[i].Start();
+                }
+                foreach (var thread in threads)
+                {
+                    thread.Join();
+                }
+                if (workerException != null)
+                {
+                    throw workerException;
+                }
+            }
+            recordPhase(phase + " render(" + tasks.Count + " files, " + Math.Max(threadCount, 1) + " threads)", watch);
+
+            foreach (var task in tasks)
+            {
+                writeGenFile(task.FilePath, task.Code ?? "", task.Hash);
+            }
+            recordPhase(phase + " write", watch);
+        }
+
         static void GenEnumWrap(IEnumerable<Type> types, string save_path)
         {
             string filePath = save_path + "EnumWrap.cs";
-            StreamWriter textWriter = new StreamWriter(filePath, false, Encoding.UTF8);
+            StringWriter textWriter = new StringWriter();
             
             GenOne(null, (type, type_info) =>
             {
@@ -625,24 +982,30 @@ namespace CSObjectWrapEditor
                 type_info.Set("types", types.ToList());
             }, templateRef.LuaEnumWrap, textWriter);
 
-            textWriter.Close();
+            writeGenFile(filePath, textWriter.ToString());
         }
 
         static void GenInterfaceBridge(IEnumerable<Type> types, string save_path)
         {
+            var tasks = new List<GenTask>();
             foreach (var wrap_type in types)
             {
                 if (!wrap_type.IsInterface) continue;
 
                 string filePath = save_path + wrap_type.ToString().Replace("+", "").Replace(".", "")
                     .Replace("`", "").Replace("&", "").Replace("[", "").Replace("]", "").Replace(",", "") + "Bridge.cs";
-                StreamWriter textWriter = new StreamWriter(filePath, false, Encoding.UTF8);
-                GenOne(wrap_type, (type, type_info) =>
+                tasks.Add(new GenTask()
                 {
-                    getInterfaceInfo(type, type_info);
-                }, templateRef.LuaInterfaceBridge, textWriter);
-                textWriter.Close();
+                    Type = wrap_type,
+                    FilePath = filePath,
+                    Template = templateRef.LuaInterfaceBridge,
+                    TypeInfoGetter = (type, type_info) =>
+                    {
+                        getInterfaceInfo(type, type_info);
+                    }
+                });
             }
+            runGenTasks(tasks, "interface bridges");
         }
 
         class ParameterInfoSimulation
@@ -883,7 +1246,7 @@ namespace CSObjectWrapEditor
         static void GenDelegateBridge(IEnumerable<Type> types, string save_path, IEnumerable<Type> hotfix_check_types)
         {
             string filePath = save_path + "DelegatesGensBridge.cs";
-            StreamWriter textWriter = new StreamWriter(filePath, false, Encoding.UTF8);
+            StringWriter textWriter = new StringWriter();
             types = types.Where(type => !type.GetMethod("Invoke").GetParameters().Any(paramInfo => paramInfo.ParameterType.IsGenericParameter));
             var hotfxDelegates = new List<MethodInfoSimulation>();
             var comparer = new MethodInfoSimulationComparer();
@@ -938,13 +1301,13 @@ namespace CSObjectWrapEditor
             {
                 type_info.Set("delegates_groups", delegates_groups.ToList());
             }, templateRef.LuaDelegateBridge, textWriter);
-            textWriter.Close();
+            writeGenFile(filePath, textWriter.ToString());
         }
 
         static void GenWrapPusher(IEnumerable<Type> types, string save_path)
         {
             string filePath = save_path + "WrapPusher.cs";
-            StreamWriter textWriter = new StreamWriter(filePath, false, Encoding.UTF8);
+            StringWriter textWriter = new StringWriter();
             var emptyMap = new Dictionary<Type, Type>();
             GenOne(typeof(ObjectTranslator), (type, type_info) =>
             {
@@ -960,7 +1323,7 @@ namespace CSObjectWrapEditor
                      .Select(t => new { Type = t, Fields = t.GetFields(BindingFlags.Public | BindingFlags.Instance | BindingFlags.DeclaredOnly) })
                      .ToList());
             }, templateRef.LuaWrapPusher, textWriter);
-            textWriter.Close();
+            writeGenFile(filePath, textWriter.ToString());
         }
 
         static void GenWrap(IEnumerable<Type> types, string save_path)
@@ -976,45 +1339,47 @@ namespace CSObjectWrapEditor
                 return type.ToString();
             });
 
+            var tasks = new List<GenTask>();
             foreach (var wrap_type in types)
             {
                 string filePath = save_path + wrap_type.ToString().Replace("+", "").Replace(".", "")
                     .Replace("`", "").Replace("&", "").Replace("[", "").Replace("]", "").Replace(",", "") + "Wrap.cs";
-                StreamWriter textWriter = new StreamWriter(filePath, false, Encoding.UTF8);
+                var task = new GenTask() { Type = wrap_type, FilePath = filePath };
                 if (wrap_type.IsEnum)
                 {
-                    GenOne(wrap_type, (type, type_info) =>
+                    task.Template = templateRef.LuaEnumWrap;
+                    task.TypeInfoGetter = (type, type_info) =>
                     {
                         type_info.Set("type", type);
                         type_info.Set("fields", type.GetFields(BindingFlags.GetField | BindingFlags.Public | BindingFlags.Static)
                             .Where(field => !isObsolete(field))
                             .ToList());
-                    }, templateRef.LuaEnumWrap, textWriter);
+                    };
                 }
                 else if (typeof(Delegate).IsAssignableFrom(wrap_type))
                 {
-
-
-                    GenOne(wrap_type, (type, type_info) =>
+                    task.Template = templateRef.LuaDelegateWrap;
+                    task.TypeInfoGetter = (type, type_info) =>
                     {
                         type_info.Set("type", type);
                         type_info.Set("delegate", type.GetMethod("Invoke"));
-                    }, templateRef.LuaDelegateWrap, textWriter);
-
+                    };
                 }
                 else
                 {
-                    GenOne(wrap_type, (type, type_info) =>
+                    task.Template = templateRef.LuaClassWrap;
+                    task.TypeInfoGetter = (type, type_info) =>
                     {
                         if (type.BaseType != null && typeMap.ContainsKey(type.BaseType.ToString()))
                         {
                             type_info.Set("base", type.BaseType);
                         }
                         getClassInfo(type, type_info);
-                    }, templateRef.LuaClassWrap, textWriter);
+                    };
                 }
-                textWriter.Close();
+                tasks.Add(task);
             }
+            runGenTasks(tasks, "wraps");
         }
 
 #if !XLUA_GENERAL
@@ -1094,7 +1459,7 @@ namespace CSObjectWrapEditor
             var itf_bridges = CSharpCallLua.Where(t => t.IsInterface);
 
             string filePath = GeneratorConfig.common_path + "XLuaGenAutoRegister.cs";
-            StreamWriter textWriter = new StreamWriter(filePath, false, Encoding.UTF8);
+            StringWriter textWriter = new StringWriter();
 
             var lookup = LuaCallCSharp.Distinct().ToDictionary(t => t);
 
@@ -1140,7 +1505,7 @@ namespace CSObjectWrapEditor
                 type_info.Set("itf_bridges", itf_bridges.ToList());
                 type_info.Set("extension_methods", extension_methods.ToList());
             }, templateRef.LuaRegister, textWriter);
-            textWriter.Close();
+            writeGenFile(filePath, textWriter.ToString());
         }
 
         public static void AllSubStruct(Type type, Action<Type> cb)
@@ -1238,12 +1603,12 @@ namespace CSObjectWrapEditor
             }
 
             string filePath = save_path + "PackUnpack.cs";
-            StreamWriter textWriter = new StreamWriter(filePath, false, Encoding.UTF8);
+            StringWriter textWriter = new StringWriter();
             GenOne(typeof(CopyByValue), (type, type_info) =>
             {
                 type_info.Set("type_infos", all_types.Distinct().Select(t => getXluaTypeInfo(t, set)).ToList());
             }, templateRef.PackUnpack, textWriter);
-            textWriter.Close();
+            writeGenFile(filePath, textWriter.ToString());
         }
 
         //lua中要使用到C#库的配置，比如C#标准库，或者Unity API，第三方库等。
@@ -1560,8 +1925,8 @@ namespace CSObjectWrapEditor
             templateCache.Clear();
             Directory.CreateDirectory(save_path);
             GenWrap(wraps, save_path);
-            GenWrapPusher(gc_optimze_list.Concat(wraps.Where(type=>type.IsEnum)).Distinct(), save_path);
-            GenPackUnpack(gc_optimze_list.Where(type => !type.IsPrimitive && SizeOf(type) != -1), save_path);
+            timePhase("wrap pusher", () => GenWrapPusher(gc_optimze_list.Concat(wraps.Where(type=>type.IsEnum)).Distinct(), save_path));
+            timePhase("pack unpack", () => GenPackUnpack(gc_optimze_list.Where(type => !type.IsPrimitive && SizeOf(type) != -1), save_path));
             GenInterfaceBridge(itf_bridges, save_path);
         }
 
@@ -1589,20 +1954,18 @@ namespace CSObjectWrapEditor
             var start = DateTime.Now;
             Directory.CreateDirectory(GeneratorConfig.common_path);
             templateRef = templates;
-            GetGenConfig(all_types.Where(type => !type.IsGenericTypeDefinition));
-            luaenv.DoString("require 'TemplateCommon'");
-            luaenv.Global.Set("IsExtensionMethod", new Func<MethodInfo, bool>(IsExtensionMethod));
-            luaenv.Global.Set("IsDelegate", new Func<Type, bool>(IsDelegate));
-            var gen_push_types_setter = luaenv.Global.Get<LuaFunction>("SetGenPushAndUpdateTypes");
-            gen_push_types_setter.Call(GCOptimizeList.Where(t => !t.IsPrimitive && SizeOf(t) != -1).Concat(LuaCallCSharp.Where(t => t.IsEnum)).Distinct().ToList());
-            var xlua_classes_setter = luaenv.Global.Get<LuaFunction>("SetXLuaClasses");
-            xlua_classes_setter.Call(XLua.Utils.GetAllTypes().Where(t => t.Namespace == "XLua").ToList());
-            GenDelegateBridges(all_types);
-            GenEnumWraps();
+            timePhase("config", () => GetGenConfig(all_types.Where(type => !type.IsGenericTypeDefinition)));
+            genPushAndUpdateTypes = GCOptimizeList.Where(t => !t.IsPrimitive && SizeOf(t) != -1).Concat(LuaCallCSharp.Where(t => t.IsEnum)).Distinct().ToList();
+            xluaClasses = XLua.Utils.GetAllTypes().Where(t => t.Namespace == "XLua").ToList();
+            timePhase("template env", () => initTemplateEnv(luaenv));
+            timePhase("load manifest", () => loadManifest());
+            timePhase("delegate bridges", () => GenDelegateBridges(all_types));
+            timePhase("enum wraps", () => GenEnumWraps());
             GenCodeForClass();
-            GenLuaRegister();
-            Console.WriteLine("finished! use " + (DateTime.Now - start).TotalMilliseconds + " ms");
-            luaenv.Dispose();
+            timePhase("register", () => GenLuaRegister());
+            timePhase("save manifest", () => saveManifest());
+            logPhaseTimes(start);
+            disposeThreadEnv();
         }
 #endif
 
@@ -1629,18 +1992,18 @@ namespace CSObjectWrapEditor
 #endif
             var start = DateTime.Now;
             Directory.CreateDirectory(GeneratorConfig.common_path);
-            GetGenConfig(XLua.Utils.GetAllTypes());
-            luaenv.DoString("require 'TemplateCommon'");
-            var gen_push_types_setter = luaenv.Global.Get<LuaFunction>("SetGenPushAndUpdateTypes");
-            gen_push_types_setter.Call(GCOptimizeList.Where(t => !t.IsPrimitive && SizeOf(t) != -1).Concat(LuaCallCSharp.Where(t => t.IsEnum)).Distinct().ToList());
-            var xlua_classes_setter = luaenv.Global.Get<LuaFunction>("SetXLuaClasses");
-            xlua_classes_setter.Call(XLua.Utils.GetAllTypes().Where(t => t.Namespace == "XLua").ToList());
-            GenDelegateBridges(XLua.Utils.GetAllTypes(false));
-            GenEnumWraps();
+            timePhase("config", () => GetGenConfig(XLua.Utils.GetAllTypes()));
+            genPushAndUpdateTypes = GCOptimizeList.Where(t => !t.IsPrimitive && SizeOf(t) != -1).Concat(LuaCallCSharp.Where(t => t.IsEnum)).Distinct().ToList();
+            xluaClasses = XLua.Utils.GetAllTypes().Where(t => t.Namespace == "XLua").ToList();
+            timePhase("template env", () => initTemplateEnv(luaenv));
+            timePhase("load manifest", () => loadManifest());
+            timePhase("delegate bridges", () => GenDelegateBridges(XLua.Utils.GetAllTypes(false)));
+            timePhase("enum wraps", () => GenEnumWraps());
             GenCodeForClass();
-            GenLuaRegister();
-            callCustomGen();
-            Debug.Log("finished! use " + (DateTime.Now - start).TotalMilliseconds + " ms");
+            timePhase("register", () => GenLuaRegister());
+            timePhase("save manifest", () => saveManifest());
+            timePhase("custom gen", () => callCustomGen());
+            logPhaseTimes(start);
             AssetDatabase.Refresh();
         }
 
@@ -1713,17 +2076,17 @@ namespace CSObjectWrapEditor
         {
             var start = DateTime.Now;
             Directory.CreateDirectory(GeneratorConfig.common_path);
-            GetGenConfig(XLua.Utils.GetAllTypes());
-            luaenv.DoString("require 'TemplateCommon'");
-            var gen_push_types_setter = luaenv.Global.Get<LuaFunction>("SetGenPushAndUpdateTypes");
-            gen_push_types_setter.Call(GCOptimizeList.Where(t => !t.IsPrimitive && SizeOf(t) != -1).Distinct().ToList());
-            var xlua_classes_setter = luaenv.Global.Get<LuaFunction>("SetXLuaClasses");
-            xlua_classes_setter.Call(XLua.Utils.GetAllTypes().Where(t => t.Namespace == "XLua").ToList());
-            GenDelegateBridges(XLua.Utils.GetAllTypes(false));
+            timePhase("config", () => GetGenConfig(XLua.Utils.GetAllTypes()));
+            genPushAndUpdateTypes = GCOptimizeList.Where(t => !t.IsPrimitive && SizeOf(t) != -1).Distinct().ToList();
+            xluaClasses = XLua.Utils.GetAllTypes().Where(t => t.Namespace == "XLua").ToList();
+            timePhase("template env", () => initTemplateEnv(luaenv));
+            timePhase("load manifest", () => loadManifest());
+            timePhase("delegate bridges", () => GenDelegateBridges(XLua.Utils.GetAllTypes(false)));
             GenCodeForClass(true);
-            GenLuaRegister(true);
-            callCustomGen();
-            Debug.Log("finished! use " + (DateTime.Now - start).TotalMilliseconds + " ms");
+            timePhase("register", () => GenLuaRegister(true));
+            timePhase("save manifest", () => saveManifest());
+            timePhase("custom gen", () => callCustomGen());
+            logPhaseTimes(start);
             AssetDatabase.Refresh();
         }
 #endif
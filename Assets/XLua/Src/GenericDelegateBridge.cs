@@ -12,7 +12,7 @@ using LuaAPI = XLua.LuaDLL.Lua;
 namespace XLua {
 	public partial class DelegateBridge : DelegateBridgeBase {
 		public void Action() {
-#if THREAD_SAFE || HOTFIX_ENABLE
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
 			lock(luaEnv.luaEnvLock) {
 #endif
 				var L = luaEnv.L;
@@ -23,13 +23,13 @@ namespace XLua {
                 if (error != 0)
                     luaEnv.ThrowExceptionFromError(oldTop);
                 LuaAPI.lua_settop(L, oldTop);
-#if THREAD_SAFE || HOTFIX_ENABLE
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
 			}
 #endif
 		}
 
 		public void Action<T1>(T1 p1) {
-#if THREAD_SAFE || HOTFIX_ENABLE
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
 			lock(luaEnv.luaEnvLock) {
 #endif
 				var L = luaEnv.L;
@@ -42,13 +42,13 @@ namespace XLua {
                 if (error != 0)
                     luaEnv.ThrowExceptionFromError(oldTop);
                 LuaAPI.lua_settop(L, oldTop);
-#if THREAD_SAFE || HOTFIX_ENABLE
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
 			}
 #endif
 		}
 
 		public void Action<T1, T2>(T1 p1, T2 p2) {
-#if THREAD_SAFE || HOTFIX_ENABLE
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
 			lock(luaEnv.luaEnvLock) {
 #endif
 				var L = luaEnv.L;
@@ -62,13 +62,13 @@ namespace XLua {
                 if (error != 0)
                     luaEnv.ThrowExceptionFromError(oldTop);
                 LuaAPI.lua_settop(L, oldTop);
-#if THREAD_SAFE || HOTFIX_ENABLE
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
 			}
 #endif
 		}
 
 		public void Action<T1, T2, T3>(T1 p1, T2 p2, T3 p3) {
-#if THREAD_SAFE || HOTFIX_ENABLE
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
 			lock(luaEnv.luaEnvLock) {
 #endif
 				var L = luaEnv.L;
@@ -83,13 +83,13 @@ namespace XLua {
                 if (error != 0)
                     luaEnv.ThrowExceptionFromError(oldTop);
                 LuaAPI.lua_settop(L, oldTop);
-#if THREAD_SAFE || HOTFIX_ENABLE
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
 			}
 #endif
 		}
 
 		public void Action<T1, T2, T3, T4>(T1 p1, T2 p2, T3 p3, T4 p4) {
-#if THREAD_SAFE || HOTFIX_ENABLE
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
 			lock(luaEnv.luaEnvLock) {
 #endif
 				var L = luaEnv.L;
@@ -105,14 +105,14 @@ namespace XLua {
                 if (error != 0)
                     luaEnv.ThrowExceptionFromError(oldTop);
                 LuaAPI.lua_settop(L, oldTop);
-#if THREAD_SAFE || HOTFIX_ENABLE
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
 			}
 #endif
 		}
 
 
 		public TResult Func<TResult>() {
-#if THREAD_SAFE || HOTFIX_ENABLE
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
 			lock(luaEnv.luaEnvLock) {
 #endif
 				var L = luaEnv.L;
@@ -132,13 +132,13 @@ namespace XLua {
 					LuaAPI.lua_settop(L, oldTop);
 				}
 				return ret;
-#if THREAD_SAFE || HOTFIX_ENABLE
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
 			}
 #endif
 		}
 
 		public TResult Func<T1, TResult>(T1 p1) {
-#if THREAD_SAFE || HOTFIX_ENABLE
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
 			lock(luaEnv.luaEnvLock) {
 #endif
 				var L = luaEnv.L;
@@ -159,13 +159,13 @@ namespace XLua {
 					LuaAPI.lua_settop(L, oldTop);
 				}
 				return ret;
-#if THREAD_SAFE || HOTFIX_ENABLE
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
 			}
 #endif
 		}
 
 		public TResult Func<T1, T2, TResult>(T1 p1, T2 p2) {
-#if THREAD_SAFE || HOTFIX_ENABLE
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
 			lock(luaEnv.luaEnvLock) {
 #endif
 				var L = luaEnv.L;
@@ -187,13 +187,13 @@ namespace XLua {
 					LuaAPI.lua_settop(L, oldTop);
 				}
 				return ret;
-#if THREAD_SAFE || HOTFIX_ENABLE
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
 			}
 #endif
 		}
 
 		public TResult Func<T1, T2, T3, TResult>(T1 p1, T2 p2, T3 p3) {
-#if THREAD_SAFE || HOTFIX_ENABLE
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
 			lock(luaEnv.luaEnvLock) {
 #endif
 				var L = luaEnv.L;
@@ -216,13 +216,13 @@ namespace XLua {
 					LuaAPI.lua_settop(L, oldTop);
 				}
 				return ret;
-#if THREAD_SAFE || HOTFIX_ENABLE
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
 			}
 #endif
 		}
 
 		public TResult Func<T1, T2, T3, T4, TResult>(T1 p1, T2 p2, T3 p3, T4 p4) {
-#if THREAD_SAFE || HOTFIX_ENABLE
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
 			lock(luaEnv.luaEnvLock) {
 #endif
 				var L = luaEnv.L;
@@ -246,7 +246,7 @@ namespace XLua {
 					LuaAPI.lua_settop(L, oldTop);
 				}
 				return ret;
-#if THREAD_SAFE || HOTFIX_ENABLE
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
 			}
 #endif
 		}
@@ -0,0 +1,1406 @@
+﻿/*
+ * Tencent is pleased to support the open source community by making xLua available.
+ * Copyright (C) 2016 THL A29 Limited, a Tencent company. All rights reserved.
+ * Licensed under the MIT License (the "License"); you may not use this file except in compliance with the License. You may obtain a copy of the License at
+ * http://opensource.org/licenses/MIT
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the specific language governing permissions and limitations under the License.
+*/
+
+#if USE_UNI_LUA
+using LuaAPI = UniLua.Lua;
+using RealStatePtr = UniLua.ILuaState;
+using LuaCSFunction = UniLua.CSharpFunctionDelegate;
+#else
+using LuaAPI = XLua.LuaDLL.Lua;
+using RealStatePtr = System.IntPtr;
+using LuaCSFunction = XLua.LuaDLL.lua_CSFunction;
+#endif
+
+using System;
+
+namespace XLua
+{
+    // no boxing calls with up to 8 arguments: Action, Func for one result, Call with out parameters for 2 to 4 results,
+    // CallInto for any number of results of one type written to a caller owned array
+    public partial class LuaFunction : LuaBase
+    {
+        // pushes the error function and this function, returns the top to restore
+        int beginCall(RealStatePtr L)
+        {
+            int oldTop = LuaAPI.lua_gettop(L);
+            LuaAPI.load_error_func(L, luaEnv.errorFuncRef);
+            LuaAPI.lua_getref(L, luaReference);
+            return oldTop;
+        }
+
+        // results start at oldTop + 2, above the error function
+        void invoke(RealStatePtr L, int oldTop, int nArgs, int nResults)
+        {
+            if (LuaAPI.lua_pcall(L, nArgs, nResults, oldTop + 1) != 0)
+            {
+                luaEnv.ThrowExceptionFromError(oldTop);
+            }
+        }
+
+        // returns how many results were written, the ones beyond results.Length are dropped
+        int invokeInto<TResult>(RealStatePtr L, ObjectTranslator translator, int oldTop, int nArgs, TResult[] results)
+        {
+            invoke(L, oldTop, nArgs, -1);
+            try
+            {
+                int n = Math.Min(LuaAPI.lua_gettop(L) - oldTop - 1, results.Length);
+                for (int i = 0; i < n; i++)
+                {
+                    translator.Get(L, oldTop + 2 + i, out results[i]);
+                }
+                return n;
+            }
+            finally
+            {
+                LuaAPI.lua_settop(L, oldTop);
+            }
+        }
+
+        public void Action()
+        {
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            lock (luaEnv.luaEnvLock)
+            {
+#endif
+                var L = luaEnv.L;
+                int oldTop = beginCall(L);
+                invoke(L, oldTop, 0, 0);
+                LuaAPI.lua_settop(L, oldTop);
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            }
+#endif
+        }
+
+        public void Action<T1, T2, T3>(T1 a1, T2 a2, T3 a3)
+        {
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            lock (luaEnv.luaEnvLock)
+            {
+#endif
+                var L = luaEnv.L;
+                var translator = luaEnv.translator;
+                int oldTop = beginCall(L);
+                translator.PushByType(L, a1);
+                translator.PushByType(L, a2);
+                translator.PushByType(L, a3);
+                invoke(L, oldTop, 3, 0);
+                LuaAPI.lua_settop(L, oldTop);
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            }
+#endif
+        }
+
+        public void Action<T1, T2, T3, T4>(T1 a1, T2 a2, T3 a3, T4 a4)
+        {
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            lock (luaEnv.luaEnvLock)
+            {
+#endif
+                var L = luaEnv.L;
+                var translator = luaEnv.translator;
+                int oldTop = beginCall(L);
+                translator.PushByType(L, a1);
+                translator.PushByType(L, a2);
+                translator.PushByType(L, a3);
+                translator.PushByType(L, a4);
+                invoke(L, oldTop, 4, 0);
+                LuaAPI.lua_settop(L, oldTop);
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            }
+#endif
+        }
+
+        public void Action<T1, T2, T3, T4, T5>(T1 a1, T2 a2, T3 a3, T4 a4, T5 a5)
+        {
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            lock (luaEnv.luaEnvLock)
+            {
+#endif
+                var L = luaEnv.L;
+                var translator = luaEnv.translator;
+                int oldTop = beginCall(L);
+                translator.PushByType(L, a1);
+                translator.PushByType(L, a2);
+                translator.PushByType(L, a3);
+                translator.PushByType(L, a4);
+                translator.PushByType(L, a5);
+                invoke(L, oldTop, 5, 0);
+                LuaAPI.lua_settop(L, oldTop);
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            }
+#endif
+        }
+
+        public void Action<T1, T2, T3, T4, T5, T6>(T1 a1, T2 a2, T3 a3, T4 a4, T5 a5, T6 a6)
+        {
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            lock (luaEnv.luaEnvLock)
+            {
+#endif
+                var L = luaEnv.L;
+                var translator = luaEnv.translator;
+                int oldTop = beginCall(L);
+                translator.PushByType(L, a1);
+                translator.PushByType(L, a2);
+                translator.PushByType(L, a3);
+                translator.PushByType(L, a4);
+                translator.PushByType(L, a5);
+                translator.PushByType(L, a6);
+                invoke(L, oldTop, 6, 0);
+                LuaAPI.lua_settop(L, oldTop);
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            }
+#endif
+        }
+
+        public void Action<T1, T2, T3, T4, T5, T6, T7>(T1 a1, T2 a2, T3 a3, T4 a4, T5 a5, T6 a6, T7 a7)
+        {
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            lock (luaEnv.luaEnvLock)
+            {
+#endif
+                var L = luaEnv.L;
+                var translator = luaEnv.translator;
+                int oldTop = beginCall(L);
+                translator.PushByType(L, a1);
+                translator.PushByType(L, a2);
+                translator.PushByType(L, a3);
+                translator.PushByType(L, a4);
+                translator.PushByType(L, a5);
+                translator.PushByType(L, a6);
+                translator.PushByType(L, a7);
+                invoke(L, oldTop, 7, 0);
+                LuaAPI.lua_settop(L, oldTop);
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            }
+#endif
+        }
+
+        public void Action<T1, T2, T3, T4, T5, T6, T7, T8>(T1 a1, T2 a2, T3 a3, T4 a4, T5 a5, T6 a6, T7 a7, T8 a8)
+        {
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            lock (luaEnv.luaEnvLock)
+            {
+#endif
+                var L = luaEnv.L;
+                var translator = luaEnv.translator;
+                int oldTop = beginCall(L);
+                translator.PushByType(L, a1);
+                translator.PushByType(L, a2);
+                translator.PushByType(L, a3);
+                translator.PushByType(L, a4);
+                translator.PushByType(L, a5);
+                translator.PushByType(L, a6);
+                translator.PushByType(L, a7);
+                translator.PushByType(L, a8);
+                invoke(L, oldTop, 8, 0);
+                LuaAPI.lua_settop(L, oldTop);
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            }
+#endif
+        }
+
+        public TResult Func<TResult>()
+        {
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            lock (luaEnv.luaEnvLock)
+            {
+#endif
+                var L = luaEnv.L;
+                var translator = luaEnv.translator;
+                int oldTop = beginCall(L);
+                invoke(L, oldTop, 0, 1);
+                TResult ret;
+                try
+                {
+                    translator.Get(L, oldTop + 2, out ret);
+                }
+                finally
+                {
+                    LuaAPI.lua_settop(L, oldTop);
+                }
+                return ret;
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            }
+#endif
+        }
+
+        public TResult Func<T1, T2, T3, TResult>(T1 a1, T2 a2, T3 a3)
+        {
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            lock (luaEnv.luaEnvLock)
+            {
+#endif
+                var L = luaEnv.L;
+                var translator = luaEnv.translator;
+                int oldTop = beginCall(L);
+                translator.PushByType(L, a1);
+                translator.PushByType(L, a2);
+                translator.PushByType(L, a3);
+                invoke(L, oldTop, 3, 1);
+                TResult ret;
+                try
+                {
+                    translator.Get(L, oldTop + 2, out ret);
+                }
+                finally
+                {
+                    LuaAPI.lua_settop(L, oldTop);
+                }
+                return ret;
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            }
+#endif
+        }
+
+        public TResult Func<T1, T2, T3, T4, TResult>(T1 a1, T2 a2, T3 a3, T4 a4)
+        {
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            lock (luaEnv.luaEnvLock)
+            {
+#endif
+                var L = luaEnv.L;
+                var translator = luaEnv.translator;
+                int oldTop = beginCall(L);
+                translator.PushByType(L, a1);
+                translator.PushByType(L, a2);
+                translator.PushByType(L, a3);
+                translator.PushByType(L, a4);
+                invoke(L, oldTop, 4, 1);
+                TResult ret;
+                try
+                {
+                    translator.Get(L, oldTop + 2, out ret);
+                }
+                finally
+                {
+                    LuaAPI.lua_settop(L, oldTop);
+                }
+                return ret;
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            }
+#endif
+        }
+
+        public TResult Func<T1, T2, T3, T4, T5, TResult>(T1 a1, T2 a2, T3 a3, T4 a4, T5 a5)
+        {
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            lock (luaEnv.luaEnvLock)
+            {
+#endif
+                var L = luaEnv.L;
+                var translator = luaEnv.translator;
+                int oldTop = beginCall(L);
+                translator.PushByType(L, a1);
+                translator.PushByType(L, a2);
+                translator.PushByType(L, a3);
+                translator.PushByType(L, a4);
+                translator.PushByType(L, a5);
+                invoke(L, oldTop, 5, 1);
+                TResult ret;
+                try
+                {
+                    translator.Get(L, oldTop + 2, out ret);
+                }
+                finally
+                {
+                    LuaAPI.lua_settop(L, oldTop);
+                }
+                return ret;
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            }
+#endif
+        }
+
+        public TResult Func<T1, T2, T3, T4, T5, T6, TResult>(T1 a1, T2 a2, T3 a3, T4 a4, T5 a5, T6 a6)
+        {
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            lock (luaEnv.luaEnvLock)
+            {
+#endif
+                var L = luaEnv.L;
+                var translator = luaEnv.translator;
+                int oldTop = beginCall(L);
+                translator.PushByType(L, a1);
+                translator.PushByType(L, a2);
+                translator.PushByType(L, a3);
+                translator.PushByType(L, a4);
+                translator.PushByType(L, a5);
+                translator.PushByType(L, a6);
+                invoke(L, oldTop, 6, 1);
+                TResult ret;
+                try
+                {
+                    translator.Get(L, oldTop + 2, out ret);
+                }
+                finally
+                {
+                    LuaAPI.lua_settop(L, oldTop);
+                }
+                return ret;
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            }
+#endif
+        }
+
+        public TResult Func<T1, T2, T3, T4, T5, T6, T7, TResult>(T1 a1, T2 a2, T3 a3, T4 a4, T5 a5, T6 a6, T7 a7)
+        {
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            lock (luaEnv.luaEnvLock)
+            {
+#endif
+                var L = luaEnv.L;
+                var translator = luaEnv.translator;
+                int oldTop = beginCall(L);
+                translator.PushByType(L, a1);
+                translator.PushByType(L, a2);
+                translator.PushByType(L, a3);
+                translator.PushByType(L, a4);
+                translator.PushByType(L, a5);
+                translator.PushByType(L, a6);
+                translator.PushByType(L, a7);
+                invoke(L, oldTop, 7, 1);
+                TResult ret;
+                try
+                {
+                    translator.Get(L, oldTop + 2, out ret);
+                }
+                finally
+                {
+                    LuaAPI.lua_settop(L, oldTop);
+                }
+                return ret;
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            }
+#endif
+        }
+
+        public TResult Func<T1, T2, T3, T4, T5, T6, T7, T8, TResult>(T1 a1, T2 a2, T3 a3, T4 a4, T5 a5, T6 a6, T7 a7, T8 a8)
+        {
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            lock (luaEnv.luaEnvLock)
+            {
+#endif
+                var L = luaEnv.L;
+                var translator = luaEnv.translator;
+                int oldTop = beginCall(L);
+                translator.PushByType(L, a1);
+                translator.PushByType(L, a2);
+                translator.PushByType(L, a3);
+                translator.PushByType(L, a4);
+                translator.PushByType(L, a5);
+                translator.PushByType(L, a6);
+                translator.PushByType(L, a7);
+                translator.PushByType(L, a8);
+                invoke(L, oldTop, 8, 1);
+                TResult ret;
+                try
+                {
+                    translator.Get(L, oldTop + 2, out ret);
+                }
+                finally
+                {
+                    LuaAPI.lua_settop(L, oldTop);
+                }
+                return ret;
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            }
+#endif
+        }
+
+        public void Call<TResult1, TResult2>(out TResult1 r1, out TResult2 r2)
+        {
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            lock (luaEnv.luaEnvLock)
+            {
+#endif
+                var L = luaEnv.L;
+                var translator = luaEnv.translator;
+                int oldTop = beginCall(L);
+                invoke(L, oldTop, 0, 2);
+                try
+                {
+                    translator.Get(L, oldTop + 2, out r1);
+                    translator.Get(L, oldTop + 3, out r2);
+                }
+                finally
+                {
+                    LuaAPI.lua_settop(L, oldTop);
+                }
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            }
+#endif
+        }
+
+        public void Call<T1, TResult1, TResult2>(T1 a1, out TResult1 r1, out TResult2 r2)
+        {
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            lock (luaEnv.luaEnvLock)
+            {
+#endif
+                var L = luaEnv.L;
+                var translator = luaEnv.translator;
+                int oldTop = beginCall(L);
+                translator.PushByType(L, a1);
+                invoke(L, oldTop, 1, 2);
+                try
+                {
+                    translator.Get(L, oldTop + 2, out r1);
+                    translator.Get(L, oldTop + 3, out r2);
+                }
+                finally
+                {
+                    LuaAPI.lua_settop(L, oldTop);
+                }
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            }
+#endif
+        }
+
+        public void Call<T1, T2, TResult1, TResult2>(T1 a1, T2 a2, out TResult1 r1, out TResult2 r2)
+        {
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            lock (luaEnv.luaEnvLock)
+            {
+#endif
+                var L = luaEnv.L;
+                var translator = luaEnv.translator;
+                int oldTop = beginCall(L);
+                translator.PushByType(L, a1);
+                translator.PushByType(L, a2);
+                invoke(L, oldTop, 2, 2);
+                try
+                {
+                    translator.Get(L, oldTop + 2, out r1);
+                    translator.Get(L, oldTop + 3, out r2);
+                }
+                finally
+                {
+                    LuaAPI.lua_settop(L, oldTop);
+                }
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            }
+#endif
+        }
+
+        public void Call<T1, T2, T3, TResult1, TResult2>(T1 a1, T2 a2, T3 a3, out TResult1 r1, out TResult2 r2)
+        {
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            lock (luaEnv.luaEnvLock)
+            {
+#endif
+                var L = luaEnv.L;
+                var translator = luaEnv.translator;
+                int oldTop = beginCall(L);
+                translator.PushByType(L, a1);
+                translator.PushByType(L, a2);
+                translator.PushByType(L, a3);
+                invoke(L, oldTop, 3, 2);
+                try
+                {
+                    translator.Get(L, oldTop + 2, out r1);
+                    translator.Get(L, oldTop + 3, out r2);
+                }
+                finally
+                {
+                    LuaAPI.lua_settop(L, oldTop);
+                }
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            }
+#endif
+        }
+
+        public void Call<T1, T2, T3, T4, TResult1, TResult2>(T1 a1, T2 a2, T3 a3, T4 a4, out TResult1 r1, out TResult2 r2)
+        {
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            lock (luaEnv.luaEnvLock)
+            {
+#endif
+                var L = luaEnv.L;
+                var translator = luaEnv.translator;
+                int oldTop = beginCall(L);
+                translator.PushByType(L, a1);
+                translator.PushByType(L, a2);
+                translator.PushByType(L, a3);
+                translator.PushByType(L, a4);
+                invoke(L, oldTop, 4, 2);
+                try
+                {
+                    translator.Get(L, oldTop + 2, out r1);
+                    translator.Get(L, oldTop + 3, out r2);
+                }
+                finally
+                {
+                    LuaAPI.lua_settop(L, oldTop);
+                }
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            }
+#endif
+        }
+
+        public void Call<T1, T2, T3, T4, T5, TResult1, TResult2>(T1 a1, T2 a2, T3 a3, T4 a4, T5 a5, out TResult1 r1, out TResult2 r2)
+        {
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            lock (luaEnv.luaEnvLock)
+            {
+#endif
+                var L = luaEnv.L;
+                var translator = luaEnv.translator;
+                int oldTop = beginCall(L);
+                translator.PushByType(L, a1);
+                translator.PushByType(L, a2);
+                translator.PushByType(L, a3);
+                translator.PushByType(L, a4);
+                translator.PushByType(L, a5);
+                invoke(L, oldTop, 5, 2);
+                try
+                {
+                    translator.Get(L, oldTop + 2, out r1);
+                    translator.Get(L, oldTop + 3, out r2);
+                }
+                finally
+                {
+                    LuaAPI.lua_settop(L, oldTop);
+                }
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            }
+#endif
+        }
+
+        public void Call<T1, T2, T3, T4, T5, T6, TResult1, TResult2>(T1 a1, T2 a2, T3 a3, T4 a4, T5 a5, T6 a6, out TResult1 r1, out TResult2 r2)
+        {
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            lock (luaEnv.luaEnvLock)
+            {
+#endif
+                var L = luaEnv.L;
+                var translator = luaEnv.translator;
+                int oldTop = beginCall(L);
+                translator.PushByType(L, a1);
+                translator.PushByType(L, a2);
+                translator.PushByType(L, a3);
+                translator.PushByType(L, a4);
+                translator.PushByType(L, a5);
+                translator.PushByType(L, a6);
+                invoke(L, oldTop, 6, 2);
+                try
+                {
+                    translator.Get(L, oldTop + 2, out r1);
+                    translator.Get(L, oldTop + 3, out r2);
+                }
+                finally
+                {
+                    LuaAPI.lua_settop(L, oldTop);
+                }
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            }
+#endif
+        }
+
+        public void Call<T1, T2, T3, T4, T5, T6, T7, TResult1, TResult2>(T1 a1, T2 a2, T3 a3, T4 a4, T5 a5, T6 a6, T7 a7, out TResult1 r1, out TResult2 r2)
+        {
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            lock (luaEnv.luaEnvLock)
+            {
+#endif
+                var L = luaEnv.L;
+                var translator = luaEnv.translator;
+                int oldTop = beginCall(L);
+                translator.PushByType(L, a1);
+                translator.PushByType(L, a2);
+                translator.PushByType(L, a3);
+                translator.PushByType(L, a4);
+                translator.PushByType(L, a5);
+                translator.PushByType(L, a6);
+                translator.PushByType(L, a7);
+                invoke(L, oldTop, 7, 2);
+                try
+                {
+                    translator.Get(L, oldTop + 2, out r1);
+                    translator.Get(L, oldTop + 3, out r2);
+                }
+                finally
+                {
+                    LuaAPI.lua_settop(L, oldTop);
+                }
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            }
+#endif
+        }
+
+        public void Call<T1, T2, T3, T4, T5, T6, T7, T8, TResult1, TResult2>(T1 a1, T2 a2, T3 a3, T4 a4, T5 a5, T6 a6, T7 a7, T8 a8, out TResult1 r1, out TResult2 r2)
+        {
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            lock (luaEnv.luaEnvLock)
+            {
+#endif
+                var L = luaEnv.L;
+                var translator = luaEnv.translator;
+                int oldTop = beginCall(L);
+                translator.PushByType(L, a1);
+                translator.PushByType(L, a2);
+                translator.PushByType(L, a3);
+                translator.PushByType(L, a4);
+                translator.PushByType(L, a5);
+                translator.PushByType(L, a6);
+                translator.PushByType(L, a7);
+                translator.PushByType(L, a8);
+                invoke(L, oldTop, 8, 2);
+                try
+                {
+                    translator.Get(L, oldTop + 2, out r1);
+                    translator.Get(L, oldTop + 3, out r2);
+                }
+                finally
+                {
+                    LuaAPI.lua_settop(L, oldTop);
+                }
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            }
+#endif
+        }
+
+        public void Call<TResult1, TResult2, TResult3>(out TResult1 r1, out TResult2 r2, out TResult3 r3)
+        {
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            lock (luaEnv.luaEnvLock)
+            {
+#endif
+                var L = luaEnv.L;
+                var translator = luaEnv.translator;
+                int oldTop = beginCall(L);
+                invoke(L, oldTop, 0, 3);
+                try
+                {
+                    translator.Get(L, oldTop + 2, out r1);
+                    translator.Get(L, oldTop + 3, out r2);
+                    translator.Get(L, oldTop + 4, out r3);
+                }
+                finally
+                {
+                    LuaAPI.lua_settop(L, oldTop);
+                }
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            }
+#endif
+        }
+
+        public void Call<T1, TResult1, TResult2, TResult3>(T1 a1, out TResult1 r1, out TResult2 r2, out TResult3 r3)
+        {
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            lock (luaEnv.luaEnvLock)
+            {
+#endif
+                var L = luaEnv.L;
+                var translator = luaEnv.translator;
+                int oldTop = beginCall(L);
+                translator.PushByType(L, a1);
+                invoke(L, oldTop, 1, 3);
+                try
+                {
+                    translator.Get(L, oldTop + 2, out r1);
+                    translator.Get(L, oldTop + 3, out r2);
+                    translator.Get(L, oldTop + 4, out r3);
+                }
+                finally
+                {
+                    LuaAPI.lua_settop(L, oldTop);
+                }
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            }
+#endif
+        }
+
+        public void Call<T1, T2, TResult1, TResult2, TResult3>(T1 a1, T2 a2, out TResult1 r1, out TResult2 r2, out TResult3 r3)
+        {
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            lock (luaEnv.luaEnvLock)
+            {
+#endif
+                var L = luaEnv.L;
+                var translator = luaEnv.translator;
+                int oldTop = beginCall(L);
+                translator.PushByType(L, a1);
+                translator.PushByType(L, a2);
+                invoke(L, oldTop, 2, 3);
+                try
+                {
+                    translator.Get(L, oldTop + 2, out r1);
+                    translator.Get(L, oldTop + 3, out r2);
+                    translator.Get(L, oldTop + 4, out r3);
+                }
+                finally
+                {
+                    LuaAPI.lua_settop(L, oldTop);
+                }
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            }
+#endif
+        }
+
+        public void Call<T1, T2, T3, TResult1, TResult2, TResult3>(T1 a1, T2 a2, T3 a3, out TResult1 r1, out TResult2 r2, out TResult3 r3)
+        {
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            lock (luaEnv.luaEnvLock)
+            {
+#endif
+                var L = luaEnv.L;
+                var translator = luaEnv.translator;
+                int oldTop = beginCall(L);
+                translator.PushByType(L, a1);
+                translator.PushByType(L, a2);
+                translator.PushByType(L, a3);
+                invoke(L, oldTop, 3, 3);
+                try
+                {
+                    translator.Get(L, oldTop + 2, out r1);
+                    translator.Get(L, oldTop + 3, out r2);
+                    translator.Get(L, oldTop + 4, out r3);
+                }
+                finally
+                {
+                    LuaAPI.lua_settop(L, oldTop);
+                }
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            }
+#endif
+        }
+
+        public void Call<T1, T2, T3, T4, TResult1, TResult2, TResult3>(T1 a1, T2 a2, T3 a3, T4 a4, out TResult1 r1, out TResult2 r2, out TResult3 r3)
+        {
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            lock (luaEnv.luaEnvLock)
+            {
+#endif
+                var L = luaEnv.L;
+                var translator = luaEnv.translator;
+                int oldTop = beginCall(L);
+                translator.PushByType(L, a1);
+                translator.PushByType(L, a2);
+                translator.PushByType(L, a3);
+                translator.PushByType(L, a4);
+                invoke(L, oldTop, 4, 3);
+                try
+                {
+                    translator.Get(L, oldTop + 2, out r1);
+                    translator.Get(L, oldTop + 3, out r2);
+                    translator.Get(L, oldTop + 4, out r3);
+                }
+                finally
+                {
+                    LuaAPI.lua_settop(L, oldTop);
+                }
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            }
+#endif
+        }
+
+        public void Call<T1, T2, T3, T4, T5, TResult1, TResult2, TResult3>(T1 a1, T2 a2, T3 a3, T4 a4, T5 a5, out TResult1 r1, out TResult2 r2, out TResult3 r3)
+        {
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            lock (luaEnv.luaEnvLock)
+            {
+#endif
+                var L = luaEnv.L;
+                var translator = luaEnv.translator;
+                int oldTop = beginCall(L);
+                translator.PushByType(L, a1);
+                translator.PushByType(L, a2);
+                translator.PushByType(L, a3);
+                translator.PushByType(L, a4);
+                translator.PushByType(L, a5);
+                invoke(L, oldTop, 5, 3);
+                try
+                {
+                    translator.Get(L, oldTop + 2, out r1);
+                    translator.Get(L, oldTop + 3, out r2);
+                    translator.Get(L, oldTop + 4, out r3);
+                }
+                finally
+                {
+                    LuaAPI.lua_settop(L, oldTop);
+                }
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            }
+#endif
+        }
+
+        public void Call<T1, T2, T3, T4, T5, T6, TResult1, TResult2, TResult3>(T1 a1, T2 a2, T3 a3, T4 a4, T5 a5, T6 a6, out TResult1 r1, out TResult2 r2, out TResult3 r3)
+        {
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            lock (luaEnv.luaEnvLock)
+            {
+#endif
+                var L = luaEnv.L;
+                var translator = luaEnv.translator;
+                int oldTop = beginCall(L);
+                translator.PushByType(L, a1);
+                translator.PushByType(L, a2);
+                translator.PushByType(L, a3);
+                translator.PushByType(L, a4);
+                translator.PushByType(L, a5);
+                translator.PushByType(L, a6);
+                invoke(L, oldTop, 6, 3);
+                try
+                {
+                    translator.Get(L, oldTop + 2, out r1);
+                    translator.Get(L, oldTop + 3, out r2);
+                    translator.Get(L, oldTop + 4, out r3);
+                }
+                finally
+                {
+                    LuaAPI.lua_settop(L, oldTop);
+                }
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            }
+#endif
+        }
+
+        public void Call<T1, T2, T3, T4, T5, T6, T7, TResult1, TResult2, TResult3>(T1 a1, T2 a2, T3 a3, T4 a4, T5 a5, T6 a6, T7 a7, out TResult1 r1, out TResult2 r2, out TResult3 r3)
+        {
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            lock (luaEnv.luaEnvLock)
+            {
+#endif
+                var L = luaEnv.L;
+                var translator = luaEnv.translator;
+                int oldTop = beginCall(L);
+                translator.PushByType(L, a1);
+                translator.PushByType(L, a2);
+                translator.PushByType(L, a3);
+                translator.PushByType(L, a4);
+                translator.PushByType(L, a5);
+                translator.PushByType(L, a6);
+                translator.PushByType(L, a7);
+                invoke(L, oldTop, 7, 3);
+                try
+                {
+                    translator.Get(L, oldTop + 2, out r1);
+                    translator.Get(L, oldTop + 3, out r2);
+                    translator.Get(L, oldTop + 4, out r3);
+                }
+                finally
+                {
+                    LuaAPI.lua_settop(L, oldTop);
+                }
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            }
+#endif
+        }
+
+        public void Call<T1, T2, T3, T4, T5, T6, T7, T8, TResult1, TResult2, TResult3>(T1 a1, T2 a2, T3 a3, T4 a4, T5 a5, T6 a6, T7 a7, T8 a8, out TResult1 r1, out TResult2 r2, out TResult3 r3)
+        {
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            lock (luaEnv.luaEnvLock)
+            {
+#endif
+                var L = luaEnv.L;
+                var translator = luaEnv.translator;
+                int oldTop = beginCall(L);
+                translator.PushByType(L, a1);
+                translator.PushByType(L, a2);
+                translator.PushByType(L, a3);
+                translator.PushByType(L, a4);
+                translator.PushByType(L, a5);
+                translator.PushByType(L, a6);
+                translator.PushByType(L, a7);
+                translator.PushByType(L, a8);
+                invoke(L, oldTop, 8, 3);
+                try
+                {
+                    translator.Get(L, oldTop + 2, out r1);
+                    translator.Get(L, oldTop + 3, out r2);
+                    translator.Get(L, oldTop + 4, out r3);
+                }
+                finally
+                {
+                    LuaAPI.lua_settop(L, oldTop);
+                }
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            }
+#endif
+        }
+
+        public void Call<TResult1, TResult2, TResult3, TResult4>(out TResult1 r1, out TResult2 r2, out TResult3 r3, out TResult4 r4)
+        {
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            lock (luaEnv.luaEnvLock)
+            {
+#endif
+                var L = luaEnv.L;
+                var translator = luaEnv.translator;
+                int oldTop = beginCall(L);
+                invoke(L, oldTop, 0, 4);
+                try
+                {
+                    translator.Get(L, oldTop + 2, out r1);
+                    translator.Get(L, oldTop + 3, out r2);
+                    translator.Get(L, oldTop + 4, out r3);
+                    translator.Get(L, oldTop + 5, out r4);
+                }
+                finally
+                {
+                    LuaAPI.lua_settop(L, oldTop);
+                }
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            }
+#endif
+        }
+
+        public void Call<T1, TResult1, TResult2, TResult3, TResult4>(T1 a1, out TResult1 r1, out TResult2 r2, out TResult3 r3, out TResult4 r4)
+        {
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            lock (luaEnv.luaEnvLock)
+            {
+#endif
+                var L = luaEnv.L;
+                var translator = luaEnv.translator;
+                int oldTop = beginCall(L);
+                translator.PushByType(L, a1);
+                invoke(L, oldTop, 1, 4);
+                try
+                {
+                    translator.Get(L, oldTop + 2, out r1);
+                    translator.Get(L, oldTop + 3, out r2);
+                    translator.Get(L, oldTop + 4, out r3);
+                    translator.Get(L, oldTop + 5, out r4);
+                }
+                finally
+                {
+                    LuaAPI.lua_settop(L, oldTop);
+                }
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            }
+#endif
+        }
+
+        public void Call<T1, T2, TResult1, TResult2, TResult3, TResult4>(T1 a1, T2 a2, out TResult1 r1, out TResult2 r2, out TResult3 r3, out TResult4 r4)
+        {
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            lock (luaEnv.luaEnvLock)
+            {
+#endif
+                var L = luaEnv.L;
+                var translator = luaEnv.translator;
+                int oldTop = beginCall(L);
+                translator.PushByType(L, a1);
+                translator.PushByType(L, a2);
+                invoke(L, oldTop, 2, 4);
+                try
+                {
+                    translator.Get(L, oldTop + 2, out r1);
+                    translator.Get(L, oldTop + 3, out r2);
+                    translator.Get(L, oldTop + 4, out r3);
+                    translator.Get(L, oldTop + 5, out r4);
+                }
+                finally
+                {
+                    LuaAPI.lua_settop(L, oldTop);
+                }
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            }
+#endif
+        }
+
+        public void Call<T1, T2, T3, TResult1, TResult2, TResult3, TResult4>(T1 a1, T2 a2, T3 a3, out TResult1 r1, out TResult2 r2, out TResult3 r3, out TResult4 r4)
+        {
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            lock (luaEnv.luaEnvLock)
+            {
+#endif
+                var L = luaEnv.L;
+                var translator = luaEnv.translator;
+                int oldTop = beginCall(L);
+                translator.PushByType(L, a1);
+                translator.PushByType(L, a2);
+                translator.PushByType(L, a3);
+                invoke(L, oldTop, 3, 4);
+                try
+                {
+                    translator.Get(L, oldTop + 2, out r1);
+                    translator.Get(L, oldTop + 3, out r2);
+                    translator.Get(L, oldTop + 4, out r3);
+                    translator.Get(L, oldTop + 5, out r4);
+                }
+                finally
+                {
+                    LuaAPI.lua_settop(L, oldTop);
+                }
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            }
+#endif
+        }
+
+        public void Call<T1, T2, T3, T4, TResult1, TResult2, TResult3, TResult4>(T1 a1, T2 a2, T3 a3, T4 a4, out TResult1 r1, out TResult2 r2, out TResult3 r3, out TResult4 r4)
+        {
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            lock (luaEnv.luaEnvLock)
+            {
+#endif
+                var L = luaEnv.L;
+                var translator = luaEnv.translator;
+                int oldTop = beginCall(L);
+                translator.PushByType(L, a1);
+                translator.PushByType(L, a2);
+                translator.PushByType(L, a3);
+                translator.PushByType(L, a4);
+                invoke(L, oldTop, 4, 4);
+                try
+                {
+                    translator.Get(L, oldTop + 2, out r1);
+                    translator.Get(L, oldTop + 3, out r2);
+                    translator.Get(L, oldTop + 4, out r3);
+                    translator.Get(L, oldTop + 5, out r4);
+                }
+                finally
+                {
+                    LuaAPI.lua_settop(L, oldTop);
+                }
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            }
+#endif
+        }
+
+        public void Call<T1, T2, T3, T4, T5, TResult1, TResult2, TResult3, TResult4>(T1 a1, T2 a2, T3 a3, T4 a4, T5 a5, out TResult1 r1, out TResult2 r2, out TResult3 r3, out TResult4 r4)
+        {
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            lock (luaEnv.luaEnvLock)
+            {
+#endif
+                var L = luaEnv.L;
+                var translator = luaEnv.translator;
+                int oldTop = beginCall(L);
+                translator.PushByType(L, a1);
+                translator.PushByType(L, a2);
+                translator.PushByType(L, a3);
+                translator.PushByType(L, a4);
+                translator.PushByType(L, a5);
+                invoke(L, oldTop, 5, 4);
+                try
+                {
+                    translator.Get(L, oldTop + 2, out r1);
+                    translator.Get(L, oldTop + 3, out r2);
+                    translator.Get(L, oldTop + 4, out r3);
+                    translator.Get(L, oldTop + 5, out r4);
+                }
+                finally
+                {
+                    LuaAPI.lua_settop(L, oldTop);
+                }
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            }
+#endif
+        }
+
+        public void Call<T1, T2, T3, T4, T5, T6, TResult1, TResult2, TResult3, TResult4>(T1 a1, T2 a2, T3 a3, T4 a4, T5 a5, T6 a6, out TResult1 r1, out TResult2 r2, out TResult3 r3, out TResult4 r4)
+        {
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            lock (luaEnv.luaEnvLock)
+            {
+#endif
+                var L = luaEnv.L;
+                var translator = luaEnv.translator;
+                int oldTop = beginCall(L);
+                translator.PushByType(L, a1);
+                translator.PushByType(L, a2);
+                translator.PushByType(L, a3);
+                translator.PushByType(L, a4);
+                translator.PushByType(L, a5);
+                translator.PushByType(L, a6);
+                invoke(L, oldTop, 6, 4);
+                try
+                {
+                    translator.Get(L, oldTop + 2, out r1);
+                    translator.Get(L, oldTop + 3, out r2);
+                    translator.Get(L, oldTop + 4, out r3);
+                    translator.Get(L, oldTop + 5, out r4);
+                }
+                finally
+                {
+                    LuaAPI.lua_settop(L, oldTop);
+                }
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            }
+#endif
+        }
+
+        public void Call<T1, T2, T3, T4, T5, T6, T7, TResult1, TResult2, TResult3, TResult4>(T1 a1, T2 a2, T3 a3, T4 a4, T5 a5, T6 a6, T7 a7, out TResult1 r1, out TResult2 r2, out TResult3 r3, out TResult4 r4)
+        {
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            lock (luaEnv.luaEnvLock)
+            {
+#endif
+                var L = luaEnv.L;
+                var translator = luaEnv.translator;
+                int oldTop = beginCall(L);
+                translator.PushByType(L, a1);
+                translator.PushByType(L, a2);
+                translator.PushByType(L, a3);
+                translator.PushByType(L, a4);
+                translator.PushByType(L, a5);
+                translator.PushByType(L, a6);
+                translator.PushByType(L, a7);
+                invoke(L, oldTop, 7, 4);
+                try
+                {
+                    translator.Get(L, oldTop + 2, out r1);
+                    translator.Get(L, oldTop + 3, out r2);
+                    translator.Get(L, oldTop + 4, out r3);
+                    translator.Get(L, oldTop + 5, out r4);
+                }
+                finally
+                {
+                    LuaAPI.lua_settop(L, oldTop);
+                }
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            }
+#endif
+        }
+
+        public void Call<T1, T2, T3, T4, T5, T6, T7, T8, TResult1, TResult2, TResult3, TResult4>(T1 a1, T2 a2, T3 a3, T4 a4, T5 a5, T6 a6, T7 a7, T8 a8, out TResult1 r1, out TResult2 r2, out TResult3 r3, out TResult4 r4)
+        {
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            lock (luaEnv.luaEnvLock)
+            {
+#endif
+                var L = luaEnv.L;
+                var translator = luaEnv.translator;
+                int oldTop = beginCall(L);
+                translator.PushByType(L, a1);
+                translator.PushByType(L, a2);
+                translator.PushByType(L, a3);
+                translator.PushByType(L, a4);
+                translator.PushByType(L, a5);
+                translator.PushByType(L, a6);
+                translator.PushByType(L, a7);
+                translator.PushByType(L, a8);
+                invoke(L, oldTop, 8, 4);
+                try
+                {
+                    translator.Get(L, oldTop + 2, out r1);
+                    translator.Get(L, oldTop + 3, out r2);
+                    translator.Get(L, oldTop + 4, out r3);
+                    translator.Get(L, oldTop + 5, out r4);
+                }
+                finally
+                {
+                    LuaAPI.lua_settop(L, oldTop);
+                }
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            }
+#endif
+        }
+
+        public int CallInto<TResult>(TResult[] results)
+        {
+            if (results == null)
+            {
+                throw new ArgumentNullException("results");
+            }
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            lock (luaEnv.luaEnvLock)
+            {
+#endif
+                var L = luaEnv.L;
+                var translator = luaEnv.translator;
+                int oldTop = beginCall(L);
+                return invokeInto(L, translator, oldTop, 0, results);
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            }
+#endif
+        }
+
+        public int CallInto<T1, TResult>(T1 a1, TResult[] results)
+        {
+            if (results == null)
+            {
+                throw new ArgumentNullException("results");
+            }
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            lock (luaEnv.luaEnvLock)
+            {
+#endif
+                var L = luaEnv.L;
+                var translator = luaEnv.translator;
+                int oldTop = beginCall(L);
+                translator.PushByType(L, a1);
+                return invokeInto(L, translator, oldTop, 1, results);
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            }
+#endif
+        }
+
+        public int CallInto<T1, T2, TResult>(T1 a1, T2 a2, TResult[] results)
+        {
+            if (results == null)
+            {
+                throw new ArgumentNullException("results");
+            }
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            lock (luaEnv.luaEnvLock)
+            {
+#endif
+                var L = luaEnv.L;
+                var translator = luaEnv.translator;
+                int oldTop = beginCall(L);
+                translator.PushByType(L, a1);
+                translator.PushByType(L, a2);
+                return invokeInto(L, translator, oldTop, 2, results);
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            }
+#endif
+        }
+
+        public int CallInto<T1, T2, T3, TResult>(T1 a1, T2 a2, T3 a3, TResult[] results)
+        {
+            if (results == null)
+            {
+                throw new ArgumentNullException("results");
+            }
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            lock (luaEnv.luaEnvLock)
+            {
+#endif
+                var L = luaEnv.L;
+                var translator = luaEnv.translator;
+                int oldTop = beginCall(L);
+                translator.PushByType(L, a1);
+                translator.PushByType(L, a2);
+                translator.PushByType(L, a3);
+                return invokeInto(L, translator, oldTop, 3, results);
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            }
+#endif
+        }
+
+        public int CallInto<T1, T2, T3, T4, TResult>(T1 a1, T2 a2, T3 a3, T4 a4, TResult[] results)
+        {
+            if (results == null)
+            {
+                throw new ArgumentNullException("results");
+            }
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            lock (luaEnv.luaEnvLock)
+            {
+#endif
+                var L = luaEnv.L;
+                var translator = luaEnv.translator;
+                int oldTop = beginCall(L);
+                translator.PushByType(L, a1);
+                translator.PushByType(L, a2);
+                translator.PushByType(L, a3);
+                translator.PushByType(L, a4);
+                return invokeInto(L, translator, oldTop, 4, results);
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            }
+#endif
+        }
+
+        public int CallInto<T1, T2, T3, T4, T5, TResult>(T1 a1, T2 a2, T3 a3, T4 a4, T5 a5, TResult[] results)
+        {
+            if (results == null)
+            {
+                throw new ArgumentNullException("results");
+            }
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            lock (luaEnv.luaEnvLock)
+            {
+#endif
+                var L = luaEnv.L;
+                var translator = luaEnv.translator;
+                int oldTop = beginCall(L);
+                translator.PushByType(L, a1);
+                translator.PushByType(L, a2);
+                translator.PushByType(L, a3);
+                translator.PushByType(L, a4);
+                translator.PushByType(L, a5);
+                return invokeInto(L, translator, oldTop, 5, results);
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            }
+#endif
+        }
+
+        public int CallInto<T1, T2, T3, T4, T5, T6, TResult>(T1 a1, T2 a2, T3 a3, T4 a4, T5 a5, T6 a6, TResult[] results)
+        {
+            if (results == null)
+            {
+                throw new ArgumentNullException("results");
+            }
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            lock (luaEnv.luaEnvLock)
+            {
+#endif
+                var L = luaEnv.L;
+                var translator = luaEnv.translator;
+                int oldTop = beginCall(L);
+                translator.PushByType(L, a1);
+                translator.PushByType(L, a2);
+                translator.PushByType(L, a3);
+                translator.PushByType(L, a4);
+                translator.PushByType(L, a5);
+                translator.PushByType(L, a6);
+                return invokeInto(L, translator, oldTop, 6, results);
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            }
+#endif
+        }
+
+        public int CallInto<T1, T2, T3, T4, T5, T6, T7, TResult>(T1 a1, T2 a2, T3 a3, T4 a4, T5 a5, T6 a6, T7 a7, TResult[] results)
+        {
+            if (results == null)
+            {
+                throw new ArgumentNullException("results");
+            }
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            lock (luaEnv.luaEnvLock)
+            {
+#endif
+                var L = luaEnv.L;
+                var translator = luaEnv.translator;
+                int oldTop = beginCall(L);
+                translator.PushByType(L, a1);
+                translator.PushByType(L, a2);
+                translator.PushByType(L, a3);
+                translator.PushByType(L, a4);
+                translator.PushByType(L, a5);
+                translator.PushByType(L, a6);
+                translator.PushByType(L, a7);
+                return invokeInto(L, translator, oldTop, 7, results);
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            }
+#endif
+        }
+
+        public int CallInto<T1, T2, T3, T4, T5, T6, T7, T8, TResult>(T1 a1, T2 a2, T3 a3, T4 a4, T5 a5, T6 a6, T7 a7, T8 a8, TResult[] results)
+        {
+            if (results == null)
+            {
+                throw new ArgumentNullException("results");
+            }
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            lock (luaEnv.luaEnvLock)
+            {
+#endif
+                var L = luaEnv.L;
+                var translator = luaEnv.translator;
+                int oldTop = beginCall(L);
+                translator.PushByType(L, a1);
+                translator.PushByType(L, a2);
+                translator.PushByType(L, a3);
+                translator.PushByType(L, a4);
+                translator.PushByType(L, a5);
+                translator.PushByType(L, a6);
+                translator.PushByType(L, a7);
+                translator.PushByType(L, a8);
+                return invokeInto(L, translator, oldTop, 8, results);
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            }
+#endif
+        }
+    }
+}
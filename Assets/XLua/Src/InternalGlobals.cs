@@ -24,8 +24,21 @@ namespace XLua
 {
     internal partial class InternalGlobals
     {
-#if !THREAD_SAFE && !HOTFIX_ENABLE
-        internal static byte[] strBuff = new byte[256];
+#if !THREAD_SAFE && (!HOTFIX_ENABLE || THREAD_AFFINITY)
+        // envs may run on several threads (editor tools such as the code generator, LuaWorkerPool)
+        [ThreadStatic]
+        static byte[] threadStrBuff;
+        internal static byte[] strBuff
+        {
+            get
+            {
+                return threadStrBuff ?? (threadStrBuff = new byte[256]);
+            }
+            set
+            {
+                threadStrBuff = value;
+            }
+        }
 #endif
 
         internal delegate bool TryArrayGet(Type type, RealStatePtr L, ObjectTranslator translator, object obj, int index);
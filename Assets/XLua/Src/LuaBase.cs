@@ -24,7 +24,7 @@ namespace XLua
     {
         protected bool disposed;
         protected readonly int luaReference;
-        protected readonly LuaEnv luaEnv;
+        protected internal readonly LuaEnv luaEnv;
 
 #if UNITY_EDITOR || XLUA_GENERAL
         protected int _errorFuncRef { get { return luaEnv.errorFuncRef; } }
@@ -55,22 +55,23 @@ namespace XLua
             {
                 if (luaReference != 0)
                 {
-#if THREAD_SAFE || HOTFIX_ENABLE
-                    lock (luaEnv.luaEnvLock)
+                    bool is_delegate = this is DelegateBridgeBase;
+                    if (disposeManagedResources)
                     {
-#endif
-                        bool is_delegate = this is DelegateBridgeBase;
-                        if (disposeManagedResources)
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+                        lock (luaEnv.luaEnvLock)
                         {
+#endif
                             luaEnv.translator.ReleaseLuaBase(luaEnv.L, luaReference, is_delegate);
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
                         }
-                        else //will dispse by LuaEnv.GC
-                        {
-                            luaEnv.equeueGCAction(new LuaEnv.GCAction { Reference = luaReference, IsDelegate = is_delegate });
-                        }
-#if THREAD_SAFE || HOTFIX_ENABLE
-                    }
 #endif
+                    }
+                    else //will dispse by LuaEnv.GC
+                    {
+                        // the queue has its own lock, a finalizer must not wait for an env another thread holds
+                        luaEnv.equeueGCAction(new LuaEnv.GCAction { Reference = luaReference, IsDelegate = is_delegate });
+                    }
                 }
                 disposed = true;
             }
@@ -80,7 +81,7 @@ namespace XLua
         {
             if (o != null && this.GetType() == o.GetType())
             {
-#if THREAD_SAFE || HOTFIX_ENABLE
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
                 lock (luaEnv.luaEnvLock)
                 {
 #endif
@@ -94,7 +95,7 @@ namespace XLua
                     int equal = LuaAPI.lua_rawequal(L, -1, -2);
                     LuaAPI.lua_settop(L, top);
                     return (equal != 0);
-#if THREAD_SAFE || HOTFIX_ENABLE
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
                 }
 #endif
             }
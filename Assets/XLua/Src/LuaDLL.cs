@@ -300,16 +300,17 @@ namespace XLua.LuaDLL
             }
             else
             {
-#if !THREAD_SAFE && !HOTFIX_ENABLE
-                if (Encoding.UTF8.GetByteCount(str) > InternalGlobals.strBuff.Length)
+#if !THREAD_SAFE && (!HOTFIX_ENABLE || THREAD_AFFINITY)
+                var buff = InternalGlobals.strBuff;
+                if (Encoding.UTF8.GetByteCount(str) > buff.Length)
                 {
                     byte[] bytes = Encoding.UTF8.GetBytes(str);
                     xlua_pushlstring(L, bytes, bytes.Length);
                 }
                 else
                 {
-                    int bytes_len = Encoding.UTF8.GetBytes(str, 0, str.Length, InternalGlobals.strBuff, 0);
-                    xlua_pushlstring(L, InternalGlobals.strBuff, bytes_len);
+                    int bytes_len = Encoding.UTF8.GetBytes(str, 0, str.Length, buff, 0);
+                    xlua_pushlstring(L, buff, bytes_len);
                 }
 #else
                 var bytes = Encoding.UTF8.GetBytes(str);
@@ -333,15 +334,16 @@ namespace XLua.LuaDLL
 #if NATIVE_LUA_PUSHSTRING
                 lua_pushstring(L, str);
 #else
-#if !THREAD_SAFE && !HOTFIX_ENABLE
+#if !THREAD_SAFE && (!HOTFIX_ENABLE || THREAD_AFFINITY)
                 int str_len = str.Length;
-                if (InternalGlobals.strBuff.Length < str_len)
+                var buff = InternalGlobals.strBuff;
+                if (buff.Length < str_len)
                 {
-                    InternalGlobals.strBuff = new byte[str_len];
+                    InternalGlobals.strBuff = buff = new byte[str_len];
                 }
 
-                int bytes_len = Encoding.UTF8.GetBytes(str, 0, str_len, InternalGlobals.strBuff, 0);
-                xlua_pushlstring(L, InternalGlobals.strBuff, bytes_len);
+                int bytes_len = Encoding.UTF8.GetBytes(str, 0, str_len, buff, 0);
+                xlua_pushlstring(L, buff, bytes_len);
 #else
                 var bytes = Encoding.UTF8.GetBytes(str);
                 xlua_pushlstring(L, bytes, bytes.Length);
@@ -521,6 +523,12 @@ namespace XLua.LuaDLL
         [DllImport(LUADLL, CallingConvention = CallingConvention.Cdecl)]
         public static extern IntPtr xlua_pushstruct(IntPtr L, uint size, int meta_ref);
 
+        [DllImport(LUADLL, CallingConvention = CallingConvention.Cdecl)]
+        public static extern IntPtr xlua_pushstructbuffer(IntPtr L, uint size);
+
+        [DllImport(LUADLL, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int xlua_getargshape(IntPtr L, int from, [Out] int[] buff, int len);
+
         [DllImport(LUADLL, CallingConvention = CallingConvention.Cdecl)]
         public static extern void xlua_pushcstable(IntPtr L, uint field_count, int meta_ref);
 
@@ -539,6 +547,45 @@ namespace XLua.LuaDLL
         [DllImport(LUADLL, CallingConvention = CallingConvention.Cdecl)]
         public static extern int xlua_psettable_bypath(IntPtr L, int idx, string path);
 
+        [DllImport(LUADLL, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int xlua_pgettable_bykeys(IntPtr L, int idx, int keysRef);
+
+        [DllImport(LUADLL, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int xlua_psettable_bykeys(IntPtr L, int idx, int keysRef);
+
+        [DllImport(LUADLL, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int xlua_snapshot(IntPtr L, int idx, int schemaRef);
+
+        [DllImport(LUADLL, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int xlua_rawget_doubles(IntPtr L, int idx, [Out] double[] buff, int len);
+
+        [DllImport(LUADLL, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void xlua_rawset_doubles(IntPtr L, int idx, double[] buff, int len);
+
+        [DllImport(LUADLL, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int xlua_rawget_floats(IntPtr L, int idx, [Out] float[] buff, int len);
+
+        [DllImport(LUADLL, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void xlua_rawset_floats(IntPtr L, int idx, float[] buff, int len);
+
+        [DllImport(LUADLL, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int xlua_rawget_ints(IntPtr L, int idx, [Out] int[] buff, int len);
+
+        [DllImport(LUADLL, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void xlua_rawset_ints(IntPtr L, int idx, int[] buff, int len);
+
+        [DllImport(LUADLL, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int xlua_rawget_longs(IntPtr L, int idx, [Out] long[] buff, int len);
+
+        [DllImport(LUADLL, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void xlua_rawset_longs(IntPtr L, int idx, long[] buff, int len);
+
+        [DllImport(LUADLL, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int xlua_rawget_structs(IntPtr L, int idx, int typeId, int size, int len);
+
+        [DllImport(LUADLL, CallingConvention = CallingConvention.Cdecl)]
+        public static extern void xlua_unref_batch(IntPtr L, int[] refs, int count);
+
         //[DllImport(LUADLL, CallingConvention = CallingConvention.Cdecl)]
         //public static extern void xlua_pushbuffer(IntPtr L, byte[] buff);
 
@@ -580,6 +627,12 @@ namespace XLua.LuaDLL
         [DllImport(LUADLL, CallingConvention = CallingConvention.Cdecl)]
         public static extern IntPtr xlua_gl(IntPtr L);
 
+        [DllImport(LUADLL, CallingConvention = CallingConvention.Cdecl)]
+        public static extern bool xlua_settranslatorindex(IntPtr L, int index);
+
+        [DllImport(LUADLL, CallingConvention = CallingConvention.Cdecl)]
+        public static extern int xlua_gettranslatorindex(IntPtr L);
+
 #if GEN_CODE_MINIMIZE
         [DllImport(LUADLL, CallingConvention = CallingConvention.Cdecl)]
         public static extern void xlua_set_csharp_wrapper_caller(IntPtr wrapper);
@@ -37,6 +37,9 @@ namespace XLua
                 {
                     throw new InvalidOperationException("this lua env had disposed!");
                 }
+#if THREAD_AFFINITY && !THREAD_SAFE
+                assertOwnerThread();
+#endif
                 return rawL;
             }
         }
@@ -47,7 +50,12 @@ namespace XLua
 
         internal int errorFuncRef = -1;
 
-#if THREAD_SAFE || HOTFIX_ENABLE
+        internal TableSnapshot tableSnapshot = null;
+
+        internal RefScopeFrame refScope = null;
+        Stack<RefScopeFrame> refScopePool = new Stack<RefScopeFrame>();
+
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
         internal /*static*/ object luaLock = new object();
 
         internal object luaEnvLock
@@ -59,7 +67,28 @@ namespace XLua
         }
 #endif
 
-        const int LIB_VERSION_EXPECT = 105;
+#if THREAD_AFFINITY && !THREAD_SAFE
+        // THREAD_AFFINITY: hotfix builds take no lock, the env may only be entered from the thread which created it,
+        // other threads hand their work over with Post
+        readonly int ownerThreadId = System.Threading.Thread.CurrentThread.ManagedThreadId;
+
+        // hotfix entries run inside arbitrary c# methods, so they check in every build
+        internal void CheckOwnerThread()
+        {
+            if (System.Threading.Thread.CurrentThread.ManagedThreadId != ownerThreadId)
+            {
+                throw new InvalidOperationException("this lua env can only be used by the thread which created it, use LuaEnv.Post in other threads");
+            }
+        }
+
+        [System.Diagnostics.Conditional("DEBUG"), System.Diagnostics.Conditional("UNITY_ASSERTIONS")]
+        void assertOwnerThread()
+        {
+            CheckOwnerThread();
+        }
+#endif
+
+        const int LIB_VERSION_EXPECT = 112;
 
         public LuaEnv()
         {
@@ -69,7 +98,7 @@ namespace XLua
                     + LIB_VERSION_EXPECT + " but got:" + LuaAPI.xlua_get_lib_version());
             }
 
-#if THREAD_SAFE || HOTFIX_ENABLE
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
             lock(luaEnvLock)
             {
 #endif
@@ -184,7 +213,7 @@ namespace XLua
                 translator.CreateArrayMetatable(rawL);
                 translator.CreateDelegateMetatable(rawL);
                 translator.CreateEnumerablePairs(rawL);
-#if THREAD_SAFE || HOTFIX_ENABLE
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
             }
 #endif
         }
@@ -210,7 +239,7 @@ namespace XLua
 
         public T LoadString<T>(byte[] chunk, string chunkName = "chunk", LuaTable env = null)
         {
-#if THREAD_SAFE || HOTFIX_ENABLE
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
             lock (luaEnvLock)
             {
 #endif
@@ -234,7 +263,7 @@ namespace XLua
                 LuaAPI.lua_settop(_L, oldTop);
 
                 return result;
-#if THREAD_SAFE || HOTFIX_ENABLE
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
             }
 #endif
         }
@@ -252,7 +281,7 @@ namespace XLua
 
         public object[] DoString(byte[] chunk, string chunkName = "chunk", LuaTable env = null)
         {
-#if THREAD_SAFE || HOTFIX_ENABLE
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
             lock (luaEnvLock)
             {
 #endif
@@ -279,7 +308,7 @@ namespace XLua
                     ThrowExceptionFromError(oldTop);
 
                 return null;
-#if THREAD_SAFE || HOTFIX_ENABLE
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
             }
 #endif
         }
@@ -292,7 +321,7 @@ namespace XLua
 
         private void AddSearcher(LuaCSFunction searcher, int index)
         {
-#if THREAD_SAFE || HOTFIX_ENABLE
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
             lock (luaEnvLock)
             {
 #endif
@@ -313,7 +342,7 @@ namespace XLua
                 LuaAPI.lua_pushstdcallcfunction(_L, searcher);
                 LuaAPI.xlua_rawseti(_L, -2, index);
                 LuaAPI.lua_pop(_L, 1);
-#if THREAD_SAFE || HOTFIX_ENABLE
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
             }
 #endif
         }
@@ -338,23 +367,45 @@ namespace XLua
 
         public void Tick()
         {
-#if THREAD_SAFE || HOTFIX_ENABLE
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
             lock (luaEnvLock)
             {
 #endif
                 var _L = L;
+                // a failing posted action does not stop the others nor the release of refs, the first error is rethrown at the end
+                Exception postException = null;
+                while (true)
+                {
+                    Action action;
+                    lock (postQueue)
+                    {
+                        if (postQueue.Count == 0) break;
+                        action = postQueue.Dequeue();
+                    }
+                    try
+                    {
+                        action();
+                    }
+                    catch (Exception e)
+                    {
+                        if (postException == null) postException = e;
+                    }
+                }
                 lock (refQueue)
                 {
-                    while (refQueue.Count > 0)
+                    if (refQueue.Count > 0)
                     {
-                        GCAction gca = refQueue.Dequeue();
-                        translator.ReleaseLuaBase(_L, gca.Reference, gca.IsDelegate);
+                        translator.ReleaseLuaBases(_L, refQueue);
                     }
                 }
 #if !XLUA_GENERAL
                 last_check_point = translator.objects.Check(last_check_point, max_check_per_tick, object_valid_checker, translator.reverseMap);
 #endif
-#if THREAD_SAFE || HOTFIX_ENABLE
+                if (postException != null)
+                {
+                    throw postException;
+                }
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
             }
 #endif
         }
@@ -367,7 +418,7 @@ namespace XLua
 
         public LuaTable NewTable()
         {
-#if THREAD_SAFE || HOTFIX_ENABLE
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
             lock (luaEnvLock)
             {
 #endif
@@ -379,7 +430,34 @@ namespace XLua
 
                 LuaAPI.lua_settop(_L, oldTop);
                 return returnVal;
-#if THREAD_SAFE || HOTFIX_ENABLE
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            }
+#endif
+        }
+
+        // split path once for LuaTable.GetInPath/SetInPath, segments are the same as for the string version
+        public LuaPath CompilePath(string path)
+        {
+            if (path == null)
+            {
+                throw new ArgumentNullException("path");
+            }
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            lock (luaEnvLock)
+            {
+#endif
+                var _L = L;
+                var keys = path.Split('.');
+                LuaAPI.lua_createtable(_L, keys.Length, 0);
+                LuaAPI.lua_pushstring(_L, path);
+                LuaAPI.xlua_rawseti(_L, -2, 0);
+                for (int i = 0; i < keys.Length; i++)
+                {
+                    LuaAPI.lua_pushstring(_L, keys[i]);
+                    LuaAPI.xlua_rawseti(_L, -2, i + 1);
+                }
+                return new LuaPath(LuaAPI.luaL_ref(_L), this, path);
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
             }
 #endif
         }
@@ -388,6 +466,10 @@ namespace XLua
 
         public void Dispose()
         {
+            if (!disposed)
+            {
+                translator.ClearDelegateBridgePool();
+            }
             FullGc();
             System.GC.Collect();
             System.GC.WaitForPendingFinalizers();
@@ -400,7 +482,7 @@ namespace XLua
 
         public virtual void Dispose(bool dispose)
         {
-#if THREAD_SAFE || HOTFIX_ENABLE
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
             lock (luaEnvLock)
             {
 #endif
@@ -420,14 +502,14 @@ namespace XLua
                 rawL = IntPtr.Zero;
 
                 disposed = true;
-#if THREAD_SAFE || HOTFIX_ENABLE
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
             }
 #endif
         }
 
         public void ThrowExceptionFromError(int oldTop)
         {
-#if THREAD_SAFE || HOTFIX_ENABLE
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
             lock (luaEnvLock)
             {
 #endif
@@ -441,7 +523,7 @@ namespace XLua
                 // A non-wrapped Lua error (best interpreted as a string) - wrap it and throw it
                 if (err == null) err = "Unknown Lua Error";
                 throw new LuaException(err.ToString());
-#if THREAD_SAFE || HOTFIX_ENABLE
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
             }
 #endif
         }
@@ -462,6 +544,21 @@ namespace XLua
             }
         }
 
+        Queue<Action> postQueue = new Queue<Action>();
+
+        // can be called from any thread, action runs in the next Tick, on the thread which ticks this env
+        public void Post(Action action)
+        {
+            if (action == null)
+            {
+                throw new ArgumentNullException("action");
+            }
+            lock (postQueue)
+            {
+                postQueue.Enqueue(action);
+            }
+        }
+
         private string init_xlua = @" 
             local metatable = {}
             local rawget = rawget
@@ -607,6 +704,18 @@ namespace XLua
             customLoaders.Add(loader);
         }
 
+        internal List<LuaModuleImage> moduleImages = new List<LuaModuleImage>();
+
+        // modules in the image are loaded from its bytecode, ahead of the CustomLoaders
+        public void AddModuleImage(LuaModuleImage image)
+        {
+            if (moduleImages.Count == 0)
+            {
+                AddSearcher(StaticLuaCallbacks.LoadFromModuleImages, 3);
+            }
+            moduleImages.Add(image);
+        }
+
         internal Dictionary<string, LuaCSFunction> buildin_initer = new Dictionary<string, LuaCSFunction>();
 
         public void AddBuildin(string name, LuaCSFunction initer)
@@ -626,25 +735,25 @@ namespace XLua
         {
             get
             {
-#if THREAD_SAFE || HOTFIX_ENABLE
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
                 lock (luaEnvLock)
                 {
 #endif
                     int val = LuaAPI.lua_gc(L, LuaGCOptions.LUA_GCSETPAUSE, 200);
                     LuaAPI.lua_gc(L, LuaGCOptions.LUA_GCSETPAUSE, val);
                     return val;
-#if THREAD_SAFE || HOTFIX_ENABLE
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
                 }
 #endif
             }
             set
             {
-#if THREAD_SAFE || HOTFIX_ENABLE
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
                 lock (luaEnvLock)
                 {
 #endif
                     LuaAPI.lua_gc(L, LuaGCOptions.LUA_GCSETPAUSE, value);
-#if THREAD_SAFE || HOTFIX_ENABLE
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
                 }
 #endif
             }
@@ -659,74 +768,224 @@ namespace XLua
         {
             get
             {
-#if THREAD_SAFE || HOTFIX_ENABLE
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
                 lock (luaEnvLock)
                 {
 #endif
                     int val = LuaAPI.lua_gc(L, LuaGCOptions.LUA_GCSETSTEPMUL, 200);
                     LuaAPI.lua_gc(L, LuaGCOptions.LUA_GCSETSTEPMUL, val);
                     return val;
-#if THREAD_SAFE || HOTFIX_ENABLE
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
                 }
 #endif
             }
             set
             {
-#if THREAD_SAFE || HOTFIX_ENABLE
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
                 lock (luaEnvLock)
                 {
 #endif
                     LuaAPI.lua_gc(L, LuaGCOptions.LUA_GCSETSTEPMUL, value);
-#if THREAD_SAFE || HOTFIX_ENABLE
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+                }
+#endif
+            }
+        }
+
+        //Number of distinct C# string instances whose lua strings are kept referenced, so pushing the
+        //same instance again is a registry lookup instead of an encode and rehash. 0 (default) turns
+        //the cache off; when it is full it is flushed and refilled.
+        public int StringCacheSize
+        {
+            get
+            {
+                return translator.StringCacheSize;
+            }
+            set
+            {
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+                lock (luaEnvLock)
+                {
+#endif
+                    translator.StringCacheSize = value;
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+                }
+#endif
+            }
+        }
+
+        // LuaTable/LuaFunction objects created until the scope is disposed are released at that point, without finalizers
+        public LuaRefScope BeginRefScope()
+        {
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            lock (luaEnvLock)
+            {
+#endif
+                int threadId = System.Threading.Thread.CurrentThread.ManagedThreadId;
+                if (refScope != null && refScope.OwnerThreadId != threadId)
+                {
+                    throw new InvalidOperationException("a ref scope of this env is open on another thread");
                 }
+                var frame = refScopePool.Count > 0 ? refScopePool.Pop() : new RefScopeFrame();
+                frame.Parent = refScope;
+                frame.OwnerThreadId = threadId;
+                refScope = frame;
+                return new LuaRefScope(this, frame);
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            }
+#endif
+        }
+
+        internal void endRefScope(RefScopeFrame frame)
+        {
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            lock (luaEnvLock)
+            {
 #endif
+                if (refScope != frame)
+                {
+                    throw new InvalidOperationException("ref scopes must be disposed in reverse order of creation");
+                }
+                if (frame.OwnerThreadId != System.Threading.Thread.CurrentThread.ManagedThreadId)
+                {
+                    throw new InvalidOperationException("a ref scope must be disposed by the thread which began it");
+                }
+                var objects = frame.Objects;
+                try
+                {
+                    if (!disposed)
+                    {
+                        for (int i = 0; i < objects.Count; i++)
+                        {
+                            objects[i].Dispose();
+                        }
+                    }
+                }
+                finally
+                {
+                    objects.Clear();
+                    refScope = frame.Parent;
+                    frame.Parent = null;
+                    frame.Version++;
+                    refScopePool.Push(frame);
+                }
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
             }
+#endif
+        }
+
+        //When on, fetching a lua table or function which already has a live LuaTable/LuaFunction returns that
+        //same instance instead of a new ref and a new finalizable object. Off by default: the instance is then
+        //shared, disposing it invalidates it for every holder.
+        public bool LuaBaseCacheEnabled
+        {
+            get
+            {
+                return translator.LuaBaseCacheEnabled;
+            }
+            set
+            {
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+                lock (luaEnvLock)
+                {
+#endif
+                    translator.LuaBaseCacheEnabled = value;
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+                }
+#endif
+            }
+        }
+
+        //Keeps the latest count delegate bridges alive, so code which drops a delegate and casts the same lua
+        //function again (rebinding a callback every frame) gets the same bridge and delegate back. 0 by default,
+        //the pool is emptied by Dispose.
+        public int DelegateBridgePoolSize
+        {
+            get
+            {
+                return translator.DelegateBridgePoolSize;
+            }
+            set
+            {
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+                lock (luaEnvLock)
+                {
+#endif
+                    translator.DelegateBridgePoolSize = value;
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+                }
+#endif
+            }
+        }
+
+        public DelegateBridgeStats GetDelegateBridgeStats()
+        {
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            lock (luaEnvLock)
+            {
+#endif
+                return translator.delegateBridgeStats;
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            }
+#endif
+        }
+
+        public void ResetDelegateBridgeStats()
+        {
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            lock (luaEnvLock)
+            {
+#endif
+                translator.delegateBridgeStats = new DelegateBridgeStats();
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            }
+#endif
         }
 
         public void FullGc()
         {
-#if THREAD_SAFE || HOTFIX_ENABLE
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
             lock (luaEnvLock)
             {
 #endif
                 LuaAPI.lua_gc(L, LuaGCOptions.LUA_GCCOLLECT, 0);
-#if THREAD_SAFE || HOTFIX_ENABLE
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
             }
 #endif
         }
 
         public void StopGc()
         {
-#if THREAD_SAFE || HOTFIX_ENABLE
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
             lock (luaEnvLock)
             {
 #endif
                 LuaAPI.lua_gc(L, LuaGCOptions.LUA_GCSTOP, 0);
-#if THREAD_SAFE || HOTFIX_ENABLE
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
             }
 #endif
         }
 
         public void RestartGc()
         {
-#if THREAD_SAFE || HOTFIX_ENABLE
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
             lock (luaEnvLock)
             {
 #endif
                 LuaAPI.lua_gc(L, LuaGCOptions.LUA_GCRESTART, 0);
-#if THREAD_SAFE || HOTFIX_ENABLE
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
             }
 #endif
         }
 
         public bool GcStep(int data)
         {
-#if THREAD_SAFE || HOTFIX_ENABLE
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
             lock (luaEnvLock)
             {
 #endif
                 return LuaAPI.lua_gc(L, LuaGCOptions.LUA_GCSTEP, data) != 0;
-#if THREAD_SAFE || HOTFIX_ENABLE
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
             }
 #endif
         }
@@ -735,12 +994,12 @@ namespace XLua
         {
             get
             {
-#if THREAD_SAFE || HOTFIX_ENABLE
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
                 lock (luaEnvLock)
                 {
 #endif
                     return LuaAPI.lua_gc(L, LuaGCOptions.LUA_GCCOUNT, 0);
-#if THREAD_SAFE || HOTFIX_ENABLE
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
                 }
 #endif
             }
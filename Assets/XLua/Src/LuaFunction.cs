@@ -29,9 +29,10 @@ namespace XLua
 
         //Action和Func是方便使用的无gc api，如果需要用到out，ref参数，建议使用delegate
         //如果需要其它个数的Action和Func， 这个类声明为partial，可以自己加
+        //GenericLuaFunction.cs has Action and Func up to 8 arguments, Call with out parameters for 2 to 4 results and CallInto
         public void Action<T>(T a)
         {
-#if THREAD_SAFE || HOTFIX_ENABLE
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
             lock (luaEnv.luaEnvLock)
             {
 #endif
@@ -45,14 +46,14 @@ namespace XLua
                 if (error != 0)
                     luaEnv.ThrowExceptionFromError(oldTop);
                 LuaAPI.lua_settop(L, oldTop);
-#if THREAD_SAFE || HOTFIX_ENABLE
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
             }
 #endif
         }
 
         public TResult Func<T, TResult>(T a)
         {
-#if THREAD_SAFE || HOTFIX_ENABLE
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
             lock (luaEnv.luaEnvLock)
             {
 #endif
@@ -79,14 +80,14 @@ namespace XLua
                     LuaAPI.lua_settop(L, oldTop);
                 }
                 return ret;
-#if THREAD_SAFE || HOTFIX_ENABLE
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
             }
 #endif
         }
 
         public void Action<T1, T2>(T1 a1, T2 a2)
         {
-#if THREAD_SAFE || HOTFIX_ENABLE
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
             lock (luaEnv.luaEnvLock)
             {
 #endif
@@ -101,14 +102,14 @@ namespace XLua
                 if (error != 0)
                     luaEnv.ThrowExceptionFromError(oldTop);
                 LuaAPI.lua_settop(L, oldTop);
-#if THREAD_SAFE || HOTFIX_ENABLE
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
             }
 #endif
         }
 
         public TResult Func<T1, T2, TResult>(T1 a1, T2 a2)
         {
-#if THREAD_SAFE || HOTFIX_ENABLE
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
             lock (luaEnv.luaEnvLock)
             {
 #endif
@@ -136,7 +137,7 @@ namespace XLua
                     LuaAPI.lua_settop(L, oldTop);
                 }
                 return ret;
-#if THREAD_SAFE || HOTFIX_ENABLE
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
             }
 #endif
         }
@@ -144,7 +145,7 @@ namespace XLua
         //deprecated
         public object[] Call(object[] args, Type[] returnTypes)
         {
-#if THREAD_SAFE || HOTFIX_ENABLE
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
             lock (luaEnv.luaEnvLock)
             {
 #endif
@@ -172,7 +173,7 @@ namespace XLua
                     return translator.popValues(L, oldTop, returnTypes);
                 else
                     return translator.popValues(L, oldTop);
-#if THREAD_SAFE || HOTFIX_ENABLE
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
             }
 #endif
         }
@@ -189,7 +190,7 @@ namespace XLua
             {
                 throw new InvalidOperationException(typeof(T).Name + " is not a delegate type");
             }
-#if THREAD_SAFE || HOTFIX_ENABLE
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
             lock (luaEnv.luaEnvLock)
             {
 #endif
@@ -199,14 +200,14 @@ namespace XLua
                 T ret = (T)translator.GetObject(L, -1, typeof(T));
                 LuaAPI.lua_pop(luaEnv.L, 1);
                 return ret;
-#if THREAD_SAFE || HOTFIX_ENABLE
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
             }
 #endif
         }
 
         public void SetEnv(LuaTable env)
         {
-#if THREAD_SAFE || HOTFIX_ENABLE
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
             lock (luaEnv.luaEnvLock)
             {
 #endif
@@ -216,7 +217,7 @@ namespace XLua
                 env.push(L);
                 LuaAPI.lua_setfenv(L, -2);
                 LuaAPI.lua_settop(L, oldTop);
-#if THREAD_SAFE || HOTFIX_ENABLE
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
             }
 #endif
         }
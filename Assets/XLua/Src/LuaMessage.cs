@@ -0,0 +1,381 @@
+﻿/*
+ * Tencent is pleased to support the open source community by making xLua available.
+ * Copyright (C) 2016 THL A29 Limited, a Tencent company. All rights reserved.
+ * Licensed under the MIT License (the "License"); you may not use this file except in compliance with the License. You may obtain a copy of the License at
+ * http://opensource.org/licenses/MIT
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the specific language governing permissions and limitations under the License.
+*/
+
+#if USE_UNI_LUA
+using LuaAPI = UniLua.Lua;
+using RealStatePtr = UniLua.ILuaState;
+using LuaCSFunction = UniLua.CSharpFunctionDelegate;
+#else
+using LuaAPI = XLua.LuaDLL.Lua;
+using RealStatePtr = System.IntPtr;
+using LuaCSFunction = XLua.LuaDLL.lua_CSFunction;
+#endif
+
+using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Reflection;
+using System.Runtime.CompilerServices;
+
+namespace XLua
+{
+    // a list of lua values copied out of one env so it can be unpacked in another, possibly on another thread.
+    // nil, boolean, number, string, table (no cycle) and value types which hold no reference can be copied,
+    // functions, userdata of c# reference types and threads can not
+    public sealed class LuaMessage
+    {
+        enum Tag : byte
+        {
+            Nil,
+            False,
+            True,
+            Int64,
+            Number,
+            String,
+            Table,
+            TableEnd,
+            Value,
+        }
+
+        const int MAX_DEPTH = 64;
+
+        byte[] data;
+        object[] values;
+
+        public int Count { get; private set; }
+
+        LuaMessage()
+        {
+        }
+
+        // LuaTable arguments are read through their own env, so this must run on the thread which uses that env
+        public static LuaMessage Pack(params object[] args)
+        {
+            var writer = new Writer();
+            if (args != null)
+            {
+                for (int i = 0; i < args.Length; i++)
+                {
+                    writer.WriteObject(args[i]);
+                }
+            }
+            return writer.ToMessage(args == null ? 0 : args.Length);
+        }
+
+        internal static LuaMessage PackStack(RealStatePtr L, ObjectTranslator translator, int from, int to)
+        {
+            var writer = new Writer();
+            for (int i = from; i <= to; i++)
+            {
+                writer.WriteStack(L, translator, i, 0);
+            }
+            return writer.ToMessage(to - from + 1);
+        }
+
+        // tables come back as LuaTable of env
+        public object[] Unpack(LuaEnv env)
+        {
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            lock (env.luaEnvLock)
+            {
+#endif
+                var L = env.L;
+                int oldTop = LuaAPI.lua_gettop(L);
+                PushValues(L, env.translator);
+                var result = env.translator.popValues(L, oldTop);
+                LuaAPI.lua_settop(L, oldTop);
+                return result ?? new object[0];
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            }
+#endif
+        }
+
+        internal int PushValues(RealStatePtr L, ObjectTranslator translator)
+        {
+            if (!LuaAPI.lua_checkstack(L, Count + MAX_DEPTH * 2))
+            {
+                throw new LuaException("stack overflow while unpacking a message");
+            }
+            using (var reader = new BinaryReader(new MemoryStream(data, false)))
+            {
+                for (int i = 0; i < Count; i++)
+                {
+                    pushValue(L, translator, reader, (Tag)reader.ReadByte());
+                }
+            }
+            return Count;
+        }
+
+        void pushValue(RealStatePtr L, ObjectTranslator translator, BinaryReader reader, Tag tag)
+        {
+            switch (tag)
+            {
+                case Tag.Nil:
+                    LuaAPI.lua_pushnil(L);
+                    break;
+                case Tag.False:
+                    LuaAPI.lua_pushboolean(L, false);
+                    break;
+                case Tag.True:
+                    LuaAPI.lua_pushboolean(L, true);
+                    break;
+                case Tag.Int64:
+                    LuaAPI.lua_pushint64(L, reader.ReadInt64());
+                    break;
+                case Tag.Number:
+                    LuaAPI.lua_pushnumber(L, reader.ReadDouble());
+                    break;
+                case Tag.String:
+                    var bytes = reader.ReadBytes(reader.ReadInt32());
+                    LuaAPI.xlua_pushlstring(L, bytes, bytes.Length);
+                    break;
+                case Tag.Table:
+                    LuaAPI.lua_createtable(L, reader.ReadInt32(), reader.ReadInt32());
+                    while (true)
+                    {
+                        Tag keyTag = (Tag)reader.ReadByte();
+                        if (keyTag == Tag.TableEnd) break;
+                        pushValue(L, translator, reader, keyTag);
+                        pushValue(L, translator, reader, (Tag)reader.ReadByte());
+                        LuaAPI.lua_rawset(L, -3);
+                    }
+                    break;
+                case Tag.Value:
+                    // every unpack gets its own copy, envs never share a box
+                    translator.PushAny(L, RuntimeHelpers.GetObjectValue(values[reader.ReadInt32()]));
+                    break;
+                default:
+                    throw new LuaException("corrupted message");
+            }
+        }
+
+        class Writer
+        {
+            MemoryStream stream = new MemoryStream();
+            BinaryWriter writer;
+            List<object> values = null;
+            HashSet<IntPtr> visiting = new HashSet<IntPtr>();
+
+            public Writer()
+            {
+                writer = new BinaryWriter(stream);
+            }
+
+            public LuaMessage ToMessage(int count)
+            {
+                writer.Flush();
+                return new LuaMessage()
+                {
+                    data = stream.ToArray(),
+                    values = values == null ? null : values.ToArray(),
+                    Count = count
+                };
+            }
+
+            public void WriteObject(object obj)
+            {
+                if (obj == null)
+                {
+                    writer.Write((byte)Tag.Nil);
+                }
+                else if (obj is bool)
+                {
+                    writer.Write((byte)((bool)obj ? Tag.True : Tag.False));
+                }
+                else if (obj is string)
+                {
+                    writeString(System.Text.Encoding.UTF8.GetBytes((string)obj));
+                }
+                else if (obj is byte[])
+                {
+                    writeString((byte[])obj);
+                }
+                else if (obj is LuaTable)
+                {
+                    var table = (LuaTable)obj;
+                    var env = table.luaEnv;
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+                    lock (env.luaEnvLock)
+                    {
+#endif
+                        var L = env.L;
+                        int oldTop = LuaAPI.lua_gettop(L);
+                        try
+                        {
+                            table.push(L);
+                            WriteStack(L, env.translator, oldTop + 1, 0);
+                        }
+                        finally
+                        {
+                            LuaAPI.lua_settop(L, oldTop);
+                        }
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+                    }
+#endif
+                }
+                else
+                {
+                    writeValue(obj);
+                }
+            }
+
+            public void WriteStack(RealStatePtr L, ObjectTranslator translator, int idx, int depth)
+            {
+                LuaTypes type = LuaAPI.lua_type(L, idx);
+                switch (type)
+                {
+                    case LuaTypes.LUA_TNIL:
+                    case LuaTypes.LUA_TNONE:
+                        writer.Write((byte)Tag.Nil);
+                        break;
+                    case LuaTypes.LUA_TBOOLEAN:
+                        writer.Write((byte)(LuaAPI.lua_toboolean(L, idx) ? Tag.True : Tag.False));
+                        break;
+                    case LuaTypes.LUA_TNUMBER:
+                        if (LuaAPI.lua_isinteger(L, idx))
+                        {
+                            writer.Write((byte)Tag.Int64);
+                            writer.Write(LuaAPI.lua_toint64(L, idx));
+                        }
+                        else
+                        {
+                            writer.Write((byte)Tag.Number);
+                            writer.Write(LuaAPI.lua_tonumber(L, idx));
+                        }
+                        break;
+                    case LuaTypes.LUA_TSTRING:
+                        writeString(LuaAPI.lua_tobytes(L, idx));
+                        break;
+                    case LuaTypes.LUA_TTABLE:
+                        writeTable(L, translator, idx, depth);
+                        break;
+                    case LuaTypes.LUA_TUSERDATA:
+                        if (LuaAPI.lua_isint64(L, idx))
+                        {
+                            writer.Write((byte)Tag.Int64);
+                            writer.Write(LuaAPI.lua_toint64(L, idx));
+                        }
+                        else
+                        {
+                            writeValue(translator.GetObject(L, idx, typeof(object)));
+                        }
+                        break;
+                    default:
+                        throw new LuaException("a " + type + " can not be passed between lua envs");
+                }
+            }
+
+            void writeTable(RealStatePtr L, ObjectTranslator translator, int idx, int depth)
+            {
+                if (depth >= MAX_DEPTH)
+                {
+                    throw new LuaException("table nested too deep to be passed between lua envs");
+                }
+                var ptr = LuaAPI.lua_topointer(L, idx);
+                if (!visiting.Add(ptr))
+                {
+                    throw new LuaException("table with cycle can not be passed between lua envs");
+                }
+                if (idx < 0)
+                {
+                    idx = LuaAPI.lua_gettop(L) + idx + 1;
+                }
+                if (!LuaAPI.lua_checkstack(L, 3))
+                {
+                    throw new LuaException("stack overflow while packing a message");
+                }
+
+                writer.Write((byte)Tag.Table);
+                writer.Write((int)LuaAPI.xlua_objlen(L, idx));
+                long hashSizePos = stream.Position;
+                writer.Write(0);
+                int hashSize = 0;
+
+                LuaAPI.lua_pushnil(L);
+                while (LuaAPI.lua_next(L, idx) != 0)
+                {
+                    WriteStack(L, translator, -2, depth + 1);
+                    WriteStack(L, translator, -1, depth + 1);
+                    LuaAPI.lua_pop(L, 1);
+                    hashSize++;
+                }
+                writer.Write((byte)Tag.TableEnd);
+
+                long end = stream.Position;
+                stream.Position = hashSizePos;
+                writer.Write(hashSize);
+                stream.Position = end;
+
+                visiting.Remove(ptr);
+            }
+
+            void writeString(byte[] bytes)
+            {
+                writer.Write((byte)Tag.String);
+                writer.Write(bytes.Length);
+                writer.Write(bytes);
+            }
+
+            void writeValue(object obj)
+            {
+                if (obj == null)
+                {
+                    writer.Write((byte)Tag.Nil);
+                    return;
+                }
+                if (!IsCopyable(obj.GetType()))
+                {
+                    throw new LuaException(obj.GetType() + " can not be passed between lua envs, only value types without reference fields can");
+                }
+                if (values == null)
+                {
+                    values = new List<object>();
+                }
+                writer.Write((byte)Tag.Value);
+                writer.Write(values.Count);
+                values.Add(RuntimeHelpers.GetObjectValue(obj));
+            }
+        }
+
+        static Dictionary<Type, bool> copyableCache = new Dictionary<Type, bool>();
+
+        // value types whose fields are all value types, a copy of them shares nothing with the original
+        internal static bool IsCopyable(Type type)
+        {
+            if (!type.IsValueType())
+            {
+                return false;
+            }
+            if (type.IsPrimitive() || type.IsEnum())
+            {
+                return true;
+            }
+            lock (copyableCache)
+            {
+                bool copyable;
+                if (copyableCache.TryGetValue(type, out copyable))
+                {
+                    return copyable;
+                }
+                // assume copyable while checking, so recursive layouts terminate
+                copyableCache[type] = true;
+                copyable = true;
+                foreach (var field in type.GetFields(BindingFlags.Instance | BindingFlags.Public | BindingFlags.NonPublic))
+                {
+                    if (!IsCopyable(field.FieldType))
+                    {
+                        copyable = false;
+                        break;
+                    }
+                }
+                copyableCache[type] = copyable;
+                return copyable;
+            }
+        }
+    }
+}
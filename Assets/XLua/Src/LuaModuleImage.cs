@@ -0,0 +1,87 @@
+﻿/*
+ * Tencent is pleased to support the open source community by making xLua available.
+ * Copyright (C) 2016 THL A29 Limited, a Tencent company. All rights reserved.
+ * Licensed under the MIT License (the "License"); you may not use this file except in compliance with the License. You may obtain a copy of the License at
+ * http://opensource.org/licenses/MIT
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the specific language governing permissions and limitations under the License.
+*/
+
+using System;
+using System.Collections.Generic;
+
+namespace XLua
+{
+    // a set of modules compiled once to bytecode, shared read only by every env it is added to (LuaEnv.AddModuleImage).
+    // a require hitting the image loads the bytecode directly, so those envs never find, read or parse the source again.
+    // bytecode only runs on the lua build which produced it, an image should not outlive the process
+    public sealed class LuaModuleImage
+    {
+        Dictionary<string, byte[]> modules = new Dictionary<string, byte[]>();
+
+        LuaModuleImage()
+        {
+        }
+
+        public int Count
+        {
+            get
+            {
+                return modules.Count;
+            }
+        }
+
+        public IEnumerable<string> Modules
+        {
+            get
+            {
+                return modules.Keys;
+            }
+        }
+
+        internal byte[] Get(string module)
+        {
+            byte[] bytecode;
+            return modules.TryGetValue(module, out bytecode) ? bytecode : null;
+        }
+
+        // resolves each module with the searchers of env (so its loaders decide where sources come from) and dumps the chunk;
+        // modules found by a c searcher (preload, buildin) or only present in package.loaded (standard libraries) are left out,
+        // the envs still resolve them as usual
+        public static LuaModuleImage Build(LuaEnv env, IEnumerable<string> moduleNames, bool stripDebugInfo = false)
+        {
+            var image = new LuaModuleImage();
+            LuaFunction dump = env.LoadString(@"
+                local searchers = package.searchers or package.loaders
+                local name, strip = ...
+                for i = 1, #searchers do
+                    local loader = searchers[i](name)
+                    if type(loader) == 'function' then
+                        local ok, bytecode = pcall(string.dump, loader, strip)
+                        return ok and bytecode or nil
+                    end
+                end
+                if package.loaded[name] == nil then
+                    error('module ' .. name .. ' not found')
+                end
+                return nil
+            ", "module_image_dump");
+            try
+            {
+                foreach (var name in moduleNames)
+                {
+                    if (image.modules.ContainsKey(name)) continue;
+                    var bytecode = dump.Call(new object[] { name, stripDebugInfo }, new Type[] { typeof(byte[]) })[0] as byte[];
+                    if (bytecode != null)
+                    {
+                        image.modules.Add(name, bytecode);
+                    }
+                }
+            }
+            finally
+            {
+                dump.Dispose();
+            }
+            return image;
+        }
+    }
+}
@@ -0,0 +1,67 @@
+﻿/*
+ * Tencent is pleased to support the open source community by making xLua available.
+ * Copyright (C) 2016 THL A29 Limited, a Tencent company. All rights reserved.
+ * Licensed under the MIT License (the "License"); you may not use this file except in compliance with the License. You may obtain a copy of the License at
+ * http://opensource.org/licenses/MIT
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the specific language governing permissions and limitations under the License.
+*/
+
+using System;
+using System.Collections.Generic;
+
+namespace XLua
+{
+    internal class RefScopeFrame
+    {
+        public List<LuaBase> Objects = new List<LuaBase>();
+        public RefScopeFrame Parent;
+        public int Version;
+        // only objects created by this thread join the frame
+        public int OwnerThreadId;
+    }
+
+    // returned by LuaEnv.BeginRefScope, the LuaTable/LuaFunction objects the env creates until it is disposed are
+    // released right then instead of by their finalizers, which are never registered for them.
+    // scopes nest and must be disposed in reverse order, frames are pooled so a scope allocates nothing.
+    // the open scopes of an env belong to the thread which began them, objects other threads create are not tracked
+    public struct LuaRefScope : IDisposable
+    {
+        readonly LuaEnv luaEnv;
+        readonly RefScopeFrame frame;
+        readonly int version;
+
+        internal LuaRefScope(LuaEnv luaEnv, RefScopeFrame frame)
+        {
+            this.luaEnv = luaEnv;
+            this.frame = frame;
+            version = frame.Version;
+        }
+
+        // lets obj outlive the scope, it is released by its finalizer or Dispose as usual
+        public T Keep<T>(T obj) where T : LuaBase
+        {
+            checkAlive();
+            if (frame.Objects.Remove(obj))
+            {
+                GC.ReRegisterForFinalize(obj);
+            }
+            return obj;
+        }
+
+        public void Dispose()
+        {
+            if (frame != null && frame.Version == version)
+            {
+                luaEnv.endRefScope(frame);
+            }
+        }
+
+        void checkAlive()
+        {
+            if (frame == null || frame.Version != version)
+            {
+                throw new ObjectDisposedException("LuaRefScope");
+            }
+        }
+    }
+}
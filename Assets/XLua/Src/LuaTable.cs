@@ -32,7 +32,7 @@ namespace XLua
         // no boxing version get
         public void Get<TKey, TValue>(TKey key, out TValue value)
         {
-#if THREAD_SAFE || HOTFIX_ENABLE
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
             lock (luaEnv.luaEnvLock)
             {
 #endif
@@ -68,7 +68,7 @@ namespace XLua
                 {
                     LuaAPI.lua_settop(L, oldTop);
                 }
-#if THREAD_SAFE || HOTFIX_ENABLE
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
             }
 #endif
         }
@@ -76,7 +76,7 @@ namespace XLua
         // no boxing version get
         public bool ContainsKey<TKey>(TKey key)
         {
-#if THREAD_SAFE || HOTFIX_ENABLE
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
             lock (luaEnv.luaEnvLock)
             {
 #endif
@@ -99,7 +99,7 @@ namespace XLua
 
                 return ret;
 
-#if THREAD_SAFE || HOTFIX_ENABLE
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
             }
 #endif
         }
@@ -107,7 +107,7 @@ namespace XLua
         //no boxing version set
         public void Set<TKey, TValue>(TKey key, TValue value)
         {
-#if THREAD_SAFE || HOTFIX_ENABLE
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
             lock (luaEnv.luaEnvLock)
             {
 #endif
@@ -124,7 +124,7 @@ namespace XLua
                     luaEnv.ThrowExceptionFromError(oldTop);
                 }
                 LuaAPI.lua_settop(L, oldTop);
-#if THREAD_SAFE || HOTFIX_ENABLE
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
             }
 #endif
         }
@@ -132,7 +132,7 @@ namespace XLua
 
         public T GetInPath<T>(string path)
         {
-#if THREAD_SAFE || HOTFIX_ENABLE
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
             lock (luaEnv.luaEnvLock)
             {
 #endif
@@ -164,14 +164,86 @@ namespace XLua
                     LuaAPI.lua_settop(L, oldTop);
                 }
                 return value;
-#if THREAD_SAFE || HOTFIX_ENABLE
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
             }
 #endif
         }
 
+        // path compiled by LuaEnv.CompilePath, the same lookup without passing and splitting the string on every call
+        public T GetInPath<T>(LuaPath path)
+        {
+            checkPath(path);
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            lock (luaEnv.luaEnvLock)
+            {
+#endif
+                var L = luaEnv.L;
+                var translator = luaEnv.translator;
+                int oldTop = LuaAPI.lua_gettop(L);
+                LuaAPI.lua_getref(L, luaReference);
+                if (0 != LuaAPI.xlua_pgettable_bykeys(L, -1, path.keysReference))
+                {
+                    luaEnv.ThrowExceptionFromError(oldTop);
+                }
+                LuaTypes lua_type = LuaAPI.lua_type(L, -1);
+                if (lua_type == LuaTypes.LUA_TNIL && typeof(T).IsValueType())
+                {
+                    LuaAPI.lua_settop(L, oldTop);
+                    throw new InvalidCastException("can not assign nil to " + typeof(T).GetFriendlyName());
+                }
+
+                T value;
+                try
+                {
+                    translator.Get(L, -1, out value);
+                }
+                finally
+                {
+                    LuaAPI.lua_settop(L, oldTop);
+                }
+                return value;
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            }
+#endif
+        }
+
+        public void SetInPath<T>(LuaPath path, T val)
+        {
+            checkPath(path);
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            lock (luaEnv.luaEnvLock)
+            {
+#endif
+                var L = luaEnv.L;
+                int oldTop = LuaAPI.lua_gettop(L);
+                LuaAPI.lua_getref(L, luaReference);
+                luaEnv.translator.PushByType(L, val);
+                if (0 != LuaAPI.xlua_psettable_bykeys(L, -2, path.keysReference))
+                {
+                    luaEnv.ThrowExceptionFromError(oldTop);
+                }
+
+                LuaAPI.lua_settop(L, oldTop);
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            }
+#endif
+        }
+
+        void checkPath(LuaPath path)
+        {
+            if (path == null)
+            {
+                throw new ArgumentNullException("path");
+            }
+            if (path.luaEnv != luaEnv)
+            {
+                throw new ArgumentException("path " + path.Path + " is compiled by another LuaEnv");
+            }
+        }
+
         public void SetInPath<T>(string path, T val)
         {
-#if THREAD_SAFE || HOTFIX_ENABLE
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
             lock (luaEnv.luaEnvLock)
             {
 #endif
@@ -185,7 +257,71 @@ namespace XLua
                 }
 
                 LuaAPI.lua_settop(L, oldTop);
-#if THREAD_SAFE || HOTFIX_ENABLE
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            }
+#endif
+        }
+
+        // set a GCOptimize struct array as one packed buffer userdata instead of one userdata per element
+        public void SetStructBuffer<TKey, T>(TKey key, T[] array)
+        {
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            lock (luaEnv.luaEnvLock)
+            {
+#endif
+                var L = luaEnv.L;
+                int oldTop = LuaAPI.lua_gettop(L);
+                var translator = luaEnv.translator;
+
+                LuaAPI.lua_getref(L, luaReference);
+                translator.PushByType(L, key);
+                try
+                {
+                    translator.PushStructBuffer(L, array);
+                }
+                catch
+                {
+                    LuaAPI.lua_settop(L, oldTop);
+                    throw;
+                }
+
+                if (0 != LuaAPI.xlua_psettable(L, -3))
+                {
+                    luaEnv.ThrowExceptionFromError(oldTop);
+                }
+                LuaAPI.lua_settop(L, oldTop);
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            }
+#endif
+        }
+
+        // copy a buffer set by SetStructBuffer back into array
+        public void GetStructBuffer<TKey, T>(TKey key, T[] array)
+        {
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            lock (luaEnv.luaEnvLock)
+            {
+#endif
+                var L = luaEnv.L;
+                var translator = luaEnv.translator;
+                int oldTop = LuaAPI.lua_gettop(L);
+                LuaAPI.lua_getref(L, luaReference);
+                translator.PushByType(L, key);
+
+                if (0 != LuaAPI.xlua_pgettable(L, -2))
+                {
+                    luaEnv.ThrowExceptionFromError(oldTop);
+                }
+
+                try
+                {
+                    translator.GetStructBuffer(L, -1, array);
+                }
+                finally
+                {
+                    LuaAPI.lua_settop(L, oldTop);
+                }
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
             }
 #endif
         }
@@ -218,7 +354,7 @@ namespace XLua
 
         public void ForEach<TKey, TValue>(Action<TKey, TValue> action)
         {
-#if THREAD_SAFE || HOTFIX_ENABLE
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
             lock (luaEnv.luaEnvLock)
             {
 #endif
@@ -246,7 +382,162 @@ namespace XLua
                 {
                     LuaAPI.lua_settop(L, oldTop);
                 }
-#if THREAD_SAFE || HOTFIX_ENABLE
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            }
+#endif
+        }
+
+        // foreach (var kv in table.Pairs<string, int>()) walks the table like ForEach but allocates nothing and
+        // works in every build; entries whose key is not a TKey are skipped. the table and the current key stay on
+        // the stack (and the env locked in thread safe builds) until the loop ends, break included
+        public PairsEnumerator<TKey, TValue> Pairs<TKey, TValue>()
+        {
+            return new PairsEnumerator<TKey, TValue>(this);
+        }
+
+        public struct PairsEnumerator<TKey, TValue> : IDisposable
+        {
+            LuaTable table;
+            int oldTop;
+            int state; // 0: not started, 1: walking, 2: done
+            KeyValuePair<TKey, TValue> current;
+
+            internal PairsEnumerator(LuaTable table)
+            {
+                this.table = table;
+                oldTop = 0;
+                state = 0;
+                current = default(KeyValuePair<TKey, TValue>);
+            }
+
+            public PairsEnumerator<TKey, TValue> GetEnumerator()
+            {
+                return this;
+            }
+
+            public KeyValuePair<TKey, TValue> Current
+            {
+                get
+                {
+                    return current;
+                }
+            }
+
+            public bool MoveNext()
+            {
+                var luaEnv = table.luaEnv;
+                var L = luaEnv.L;
+                if (state == 0)
+                {
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+                    System.Threading.Monitor.Enter(luaEnv.luaEnvLock);
+#endif
+                    state = 1;
+                    oldTop = LuaAPI.lua_gettop(L);
+                    LuaAPI.lua_getref(L, table.luaReference);
+                    LuaAPI.lua_pushnil(L);
+                }
+                else if (state == 1)
+                {
+                    // drop the value, keep the key for lua_next
+                    LuaAPI.lua_settop(L, oldTop + 2);
+                }
+                else
+                {
+                    return false;
+                }
+
+                var translator = luaEnv.translator;
+                while (LuaAPI.lua_next(L, oldTop + 1) != 0)
+                {
+                    if (translator.Assignable<TKey>(L, -2))
+                    {
+                        TKey key;
+                        TValue val;
+                        translator.Get(L, -2, out key);
+                        translator.Get(L, -1, out val);
+                        current = new KeyValuePair<TKey, TValue>(key, val);
+                        return true;
+                    }
+                    LuaAPI.lua_pop(L, 1);
+                }
+                LuaAPI.lua_settop(L, oldTop);
+                state = 2;
+                current = default(KeyValuePair<TKey, TValue>);
+                return false;
+            }
+
+            public void Dispose()
+            {
+                if (state == 0)
+                {
+                    return;
+                }
+                if (state == 1)
+                {
+                    LuaAPI.lua_settop(table.luaEnv.L, oldTop);
+                }
+                state = 0;
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+                System.Threading.Monitor.Exit(table.luaEnv.luaEnvLock);
+#endif
+            }
+        }
+
+        // copies t[1..n] into dest, n is the smaller of Length and dest.Length, returns n.
+        // double, float, int, long and generated GCOptimize structs are read in one native loop
+        public int CopyTo<T>(T[] dest)
+        {
+            if (dest == null)
+            {
+                throw new ArgumentNullException("dest");
+            }
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            lock (luaEnv.luaEnvLock)
+            {
+#endif
+                var L = luaEnv.L;
+                int oldTop = LuaAPI.lua_gettop(L);
+                LuaAPI.lua_getref(L, luaReference);
+                int len = Math.Min((int)LuaAPI.xlua_objlen(L, -1), dest.Length);
+                try
+                {
+                    luaEnv.translator.GetArrayPart(L, -1, dest, len);
+                }
+                finally
+                {
+                    LuaAPI.lua_settop(L, oldTop);
+                }
+                return len;
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            }
+#endif
+        }
+
+        // writes src into t[1..src.Length] with rawset, the reverse of CopyTo.
+        // double, float, int and long are written in one native loop
+        public void CopyFrom<T>(T[] src)
+        {
+            if (src == null)
+            {
+                throw new ArgumentNullException("src");
+            }
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            lock (luaEnv.luaEnvLock)
+            {
+#endif
+                var L = luaEnv.L;
+                int oldTop = LuaAPI.lua_gettop(L);
+                LuaAPI.lua_getref(L, luaReference);
+                try
+                {
+                    luaEnv.translator.SetArrayPart(L, -1, src, src.Length);
+                }
+                finally
+                {
+                    LuaAPI.lua_settop(L, oldTop);
+                }
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
             }
 #endif
         }
@@ -255,7 +546,7 @@ namespace XLua
         {
             get
             {
-#if THREAD_SAFE || HOTFIX_ENABLE
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
                 lock (luaEnv.luaEnvLock)
                 {
 #endif
@@ -265,13 +556,13 @@ namespace XLua
                     var len = (int)LuaAPI.xlua_objlen(L, -1);
                     LuaAPI.lua_settop(L, oldTop);
                     return len;
-#if THREAD_SAFE || HOTFIX_ENABLE
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
                 }
 #endif
             }
         }
 
-#if THREAD_SAFE || HOTFIX_ENABLE
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
         [Obsolete("not thread safe!", true)]
 #endif
         public IEnumerable GetKeys()
@@ -289,7 +580,7 @@ namespace XLua
             LuaAPI.lua_settop(L, oldTop);
         }
 
-#if THREAD_SAFE || HOTFIX_ENABLE
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
         [Obsolete("not thread safe!", true)]
 #endif
         public IEnumerable<T> GetKeys<T>()
@@ -336,7 +627,7 @@ namespace XLua
 
         public void SetMetaTable(LuaTable metaTable)
         {
-#if THREAD_SAFE || HOTFIX_ENABLE
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
             lock (luaEnv.luaEnvLock)
             {
 #endif
@@ -344,7 +635,7 @@ namespace XLua
                 metaTable.push(luaEnv.L);
                 LuaAPI.lua_setmetatable(luaEnv.L, -2);
                 LuaAPI.lua_pop(luaEnv.L, 1);
-#if THREAD_SAFE || HOTFIX_ENABLE
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
             }
 #endif
         }
@@ -353,7 +644,7 @@ namespace XLua
         {
             var L = luaEnv.L;
             var translator = luaEnv.translator;
-#if THREAD_SAFE || HOTFIX_ENABLE
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
             lock (luaEnv.luaEnvLock)
             {
 #endif
@@ -361,9 +652,44 @@ namespace XLua
                 T ret = (T)translator.GetObject(L, -1, typeof(T));
                 LuaAPI.lua_pop(luaEnv.L, 1);
                 return ret;
-#if THREAD_SAFE || HOTFIX_ENABLE
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            }
+#endif
+        }
+
+        // reads the whole table into T with one native walk, T is made of public fields like for Cast<T>, of
+        // numbers, booleans, strings, enums, nested classes/structs, arrays and List<T>; nil leaves a field untouched
+        public T Snapshot<T>()
+        {
+            byte[] buffer;
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            lock (luaEnv.luaEnvLock)
+            {
+#endif
+                var L = luaEnv.L;
+                int oldTop = LuaAPI.lua_gettop(L);
+                if (luaEnv.tableSnapshot == null)
+                {
+                    luaEnv.tableSnapshot = new TableSnapshot(luaEnv);
+                }
+                try
+                {
+                    int schemaRef = luaEnv.tableSnapshot.GetSchemaRef(typeof(T));
+                    LuaAPI.lua_getref(L, luaReference);
+                    if (0 != LuaAPI.xlua_snapshot(L, -1, schemaRef))
+                    {
+                        luaEnv.ThrowExceptionFromError(oldTop);
+                    }
+                    buffer = TableSnapshot.CopyBuffer(L);
+                }
+                finally
+                {
+                    LuaAPI.lua_settop(L, oldTop);
+                }
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
             }
 #endif
+            return TableSnapshot.Decode<T>(buffer);
         }
 
         internal override void push(RealStatePtr L)
@@ -0,0 +1,387 @@
+﻿/*
+ * Tencent is pleased to support the open source community by making xLua available.
+ * Copyright (C) 2016 THL A29 Limited, a Tencent company. All rights reserved.
+ * Licensed under the MIT License (the "License"); you may not use this file except in compliance with the License. You may obtain a copy of the License at
+ * http://opensource.org/licenses/MIT
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the specific language governing permissions and limitations under the License.
+*/
+
+#if USE_UNI_LUA
+using LuaAPI = UniLua.Lua;
+using RealStatePtr = UniLua.ILuaState;
+using LuaCSFunction = UniLua.CSharpFunctionDelegate;
+#else
+using LuaAPI = XLua.LuaDLL.Lua;
+using RealStatePtr = System.IntPtr;
+using LuaCSFunction = XLua.LuaDLL.lua_CSFunction;
+#endif
+
+using System;
+using System.Collections.Generic;
+using System.Threading;
+
+namespace XLua
+{
+    public class LuaJob
+    {
+        internal readonly LuaWorkerPool pool;
+        internal readonly string functionPath;
+        internal readonly LuaMessage args;
+
+        volatile bool isDone = false;
+
+        public LuaMessage Result { get; private set; }
+
+        public Exception Exception { get; private set; }
+
+        internal LuaJob(LuaWorkerPool pool, string functionPath, LuaMessage args)
+        {
+            this.pool = pool;
+            this.functionPath = functionPath;
+            this.args = args;
+        }
+
+        public bool IsDone
+        {
+            get
+            {
+                return isDone;
+            }
+        }
+
+        internal void complete(LuaMessage result, Exception exception)
+        {
+            lock (this)
+            {
+                Result = result;
+                Exception = exception;
+                isDone = true;
+                Monitor.PulseAll(this);
+            }
+        }
+
+        // a worker waiting for a job of its own pool keeps running other jobs, so nested jobs can not deadlock the pool
+        public void Wait()
+        {
+            var worker = LuaWorkerPool.currentWorker;
+            if (worker != null && worker.pool == pool)
+            {
+                while (!isDone)
+                {
+                    if (!pool.runOne(worker))
+                    {
+                        lock (this)
+                        {
+                            if (!isDone) Monitor.Wait(this, 1);
+                        }
+                    }
+                }
+            }
+            else
+            {
+                lock (this)
+                {
+                    while (!isDone) Monitor.Wait(this);
+                }
+            }
+        }
+
+        // waits for the job and unpacks its return values into env, rethrows the error of the job
+        public object[] GetResults(LuaEnv env)
+        {
+            Wait();
+            if (Exception != null)
+            {
+                throw Exception;
+            }
+            return Result.Unpack(env);
+        }
+    }
+
+    // runs independent LuaEnvs on dedicated threads, jobs are global functions of those envs,
+    // arguments and results travel as LuaMessage so no lua or c# object is shared between threads.
+    // every worker owns a deque: it pops its own jobs from the back and steals from the front of the others
+    public class LuaWorkerPool : IDisposable
+    {
+        internal class Worker
+        {
+            public LuaWorkerPool pool;
+            public int index;
+            public Thread thread;
+            public LuaEnv env;
+            public LinkedList<LuaJob> jobs = new LinkedList<LuaJob>();
+            public Dictionary<string, LuaFunction> functions = new Dictionary<string, LuaFunction>();
+        }
+
+        [ThreadStatic]
+        internal static Worker currentWorker;
+
+        Worker[] workers;
+        object signal = new object();
+        int pendingJobs = 0;
+        int nextWorker = 0;
+        volatile bool disposed = false;
+        volatile Exception disposeError = null;
+
+        public int WorkerCount
+        {
+            get
+            {
+                return workers.Length;
+            }
+        }
+
+        // the pool of the calling worker thread, null on other threads
+        public static LuaWorkerPool Current
+        {
+            get
+            {
+                return currentWorker == null ? null : currentWorker.pool;
+            }
+        }
+
+        // the env of the calling worker thread, null on other threads
+        public static LuaEnv CurrentEnv
+        {
+            get
+            {
+                return currentWorker == null ? null : currentWorker.env;
+            }
+        }
+
+        // init runs on every worker thread with its new env, typically to require the modules the jobs need
+        public LuaWorkerPool(int workerCount, Action<LuaEnv> init)
+        {
+            if (workerCount <= 0)
+            {
+                workerCount = Math.Max(1, Environment.ProcessorCount - 1);
+            }
+            workers = new Worker[workerCount];
+            Exception initError = null;
+            int started = 0;
+            for (int i = 0; i < workerCount; i++)
+            {
+                var worker = new Worker() { pool = this, index = i };
+                workers[i] = worker;
+                worker.thread = new Thread(() =>
+                {
+                    currentWorker = worker;
+                    try
+                    {
+                        worker.env = new LuaEnv();
+                        if (init != null) init(worker.env);
+                    }
+                    catch (Exception e)
+                    {
+                        lock (workers)
+                        {
+                            if (initError == null) initError = e;
+                        }
+                    }
+                    lock (workers)
+                    {
+                        started++;
+                        Monitor.PulseAll(workers);
+                    }
+                    run(worker);
+                });
+                worker.thread.IsBackground = true;
+                worker.thread.Name = "LuaWorker" + i;
+                worker.thread.Start();
+            }
+
+            lock (workers)
+            {
+                while (started < workerCount) Monitor.Wait(workers);
+            }
+            if (initError != null)
+            {
+                Dispose();
+                throw initError;
+            }
+        }
+
+        // functionPath is a path of a global function, such as "ai.think", args are packed right away on the calling thread
+        public LuaJob Submit(string functionPath, params object[] args)
+        {
+            return Submit(functionPath, LuaMessage.Pack(args));
+        }
+
+        public LuaJob Submit(string functionPath, LuaMessage args)
+        {
+            var job = new LuaJob(this, functionPath, args);
+            var worker = currentWorker;
+            if (worker == null || worker.pool != this)
+            {
+                worker = workers[(Interlocked.Increment(ref nextWorker) & int.MaxValue) % workers.Length];
+            }
+            // checked and enqueued under the lock Dispose sets disposed with, so a job is either rejected here
+            // or queued before the workers start draining
+            lock (signal)
+            {
+                if (disposed)
+                {
+                    throw new ObjectDisposedException("LuaWorkerPool");
+                }
+                lock (worker.jobs)
+                {
+                    worker.jobs.AddLast(job);
+                }
+                pendingJobs++;
+                Monitor.Pulse(signal);
+            }
+            return job;
+        }
+
+        LuaJob take(Worker worker)
+        {
+            lock (worker.jobs)
+            {
+                if (worker.jobs.Count > 0)
+                {
+                    var job = worker.jobs.Last.Value;
+                    worker.jobs.RemoveLast();
+                    return job;
+                }
+            }
+            for (int i = 1; i < workers.Length; i++)
+            {
+                var victim = workers[(worker.index + i) % workers.Length];
+                lock (victim.jobs)
+                {
+                    if (victim.jobs.Count > 0)
+                    {
+                        var job = victim.jobs.First.Value;
+                        victim.jobs.RemoveFirst();
+                        return job;
+                    }
+                }
+            }
+            return null;
+        }
+
+        internal bool runOne(Worker worker)
+        {
+            var job = take(worker);
+            if (job == null)
+            {
+                return false;
+            }
+            lock (signal)
+            {
+                pendingJobs--;
+            }
+            execute(worker, job);
+            return true;
+        }
+
+        void run(Worker worker)
+        {
+            while (!disposed)
+            {
+                if (!runOne(worker))
+                {
+                    lock (signal)
+                    {
+                        if (pendingJobs == 0 && !disposed) Monitor.Wait(signal);
+                    }
+                }
+            }
+
+            LuaJob job;
+            while ((job = take(worker)) != null)
+            {
+                job.complete(null, new ObjectDisposedException("LuaWorkerPool"));
+            }
+            if (worker.env != null)
+            {
+                foreach (var function in worker.functions.Values)
+                {
+                    function.Dispose();
+                }
+                worker.functions.Clear();
+                try
+                {
+                    worker.env.Dispose();
+                    worker.env = null;
+                }
+                catch (Exception e)
+                {
+                    // rethrown by Dispose on the thread disposing the pool
+                    disposeError = e;
+                }
+            }
+        }
+
+        void execute(Worker worker, LuaJob job)
+        {
+            var env = worker.env;
+            if (env == null)
+            {
+                job.complete(null, new InvalidOperationException("lua worker failed to start"));
+                return;
+            }
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            lock (env.luaEnvLock)
+            {
+#endif
+                var L = env.L;
+                int oldTop = LuaAPI.lua_gettop(L);
+                try
+                {
+                    LuaFunction function;
+                    if (!worker.functions.TryGetValue(job.functionPath, out function))
+                    {
+                        function = env.Global.GetInPath<LuaFunction>(job.functionPath);
+                        if (function == null)
+                        {
+                            throw new LuaException("no function named " + job.functionPath + " in lua worker");
+                        }
+                        worker.functions.Add(job.functionPath, function);
+                    }
+
+                    int errFunc = LuaAPI.load_error_func(L, env.errorFuncRef);
+                    function.push(L);
+                    int nArgs = job.args.PushValues(L, env.translator);
+                    if (LuaAPI.lua_pcall(L, nArgs, -1, errFunc) != 0)
+                    {
+                        env.ThrowExceptionFromError(oldTop);
+                    }
+                    var result = LuaMessage.PackStack(L, env.translator, errFunc + 1, LuaAPI.lua_gettop(L));
+                    LuaAPI.lua_settop(L, oldTop);
+                    job.complete(result, null);
+                }
+                catch (Exception e)
+                {
+                    LuaAPI.lua_settop(L, oldTop);
+                    job.complete(null, e);
+                }
+                env.Tick();
+#if THREAD_SAFE || (HOTFIX_ENABLE && !THREAD_AFFINITY)
+            }
+#endif
+        }
+
+        public void Dispose()
+        {
+            if (disposed) return;
+            lock (signal)
+            {
+                disposed = true;
+                Monitor.PulseAll(signal);
+            }
+            var current = currentWorker;
+            foreach (var worker in workers)
+            {
+                if (worker.thread != null && (current == null || current.thread != worker.thread))
+                {
+                    worker.thread.Join();
+                }
+            }
+            if (disposeError != null)
+            {
+                throw disposeError;
+            }
+        }
+    }
+}
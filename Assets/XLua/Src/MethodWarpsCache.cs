@@ -24,7 +24,7 @@ namespace XLua
 {
     public class OverloadMethodWrap
     {
-        ObjectTranslator translator;
+        internal ObjectTranslator translator;
         Type targetType;
         MethodBase method;
 
@@ -50,6 +50,13 @@ namespace XLua
 
         Type paramsType = null;
 
+#if (UNITY_EDITOR || XLUA_GENERAL) && !NET_STANDARD_2_0
+        // calls through reflection before a typed invoker is compiled for this overload
+        const int COMPILE_THRESHOLD = 16;
+        int callCount = 0;
+        MethodInvoker invoker = null;
+#endif
+
         public bool HasDefalutValue{ get; private set; }
 
         public OverloadMethodWrap(ObjectTranslator translator, Type targetType, MethodBase method)
@@ -143,6 +150,14 @@ namespace XLua
             {
                 isVoid = false;
             }
+
+#if (UNITY_EDITOR || XLUA_GENERAL) && !NET_STANDARD_2_0
+            // Missing.Value is only understood by MethodBase.Invoke
+            if (Array.IndexOf(defaultValueArray, Missing.Value) != -1)
+            {
+                callCount = -1;
+            }
+#endif
         }
 
         public bool Check(RealStatePtr L)
@@ -239,7 +254,29 @@ namespace XLua
                 object ret = null;
 
 
-                ret = toInvoke.IsConstructor ? ((ConstructorInfo)method).Invoke(args) : method.Invoke(targetNeeded ? target : null, args);
+#if (UNITY_EDITOR || XLUA_GENERAL) && !NET_STANDARD_2_0
+                if (callCount >= 0 && ++callCount >= COMPILE_THRESHOLD)
+                {
+                    callCount = -1;
+                    try
+                    {
+                        invoker = CodeEmit.EmitMethodInvoker(method);
+                    }
+                    catch
+                    {
+                        invoker = null;
+                    }
+                }
+
+                if (invoker != null)
+                {
+                    ret = invoker(targetNeeded ? target : null, args);
+                }
+                else
+#endif
+                {
+                    ret = toInvoke.IsConstructor ? ((ConstructorInfo)method).Invoke(args) : method.Invoke(targetNeeded ? target : null, args);
+                }
 
                 if (targetNeeded && targetType.IsValueType())
                 {
@@ -283,6 +320,17 @@ namespace XLua
         private List<OverloadMethodWrap> overloads = new List<OverloadMethodWrap>();
         private bool forceCheck;
 
+        // inline cache of overload resolution, keyed on the shape of the lua arguments (see xlua_getargshape)
+        const int MAX_SHAPE_LENGTH = 8;
+        const int SHAPE_CACHE_SIZE = 4;
+        int[] argShape = new int[MAX_SHAPE_LENGTH];
+        int[][] cachedShapes = new int[SHAPE_CACHE_SIZE][];
+        int[] cachedShapeLengths = new int[SHAPE_CACHE_SIZE];
+        OverloadMethodWrap[] cachedOverloads = new OverloadMethodWrap[SHAPE_CACHE_SIZE];
+        int nextCacheSlot = 0;
+
+        ReflectionCallStat stat;
+
         public MethodWrap(string methodName, List<OverloadMethodWrap> overloads, bool forceCheck)
         {
             this.methodName = methodName;
@@ -290,17 +338,92 @@ namespace XLua
             this.forceCheck = forceCheck;
         }
 
+        public MethodWrap(Type type, string methodName, List<OverloadMethodWrap> overloads, bool forceCheck)
+            : this(methodName, overloads, forceCheck)
+        {
+            stat = ReflectionStats.GetStat(type, methodName);
+        }
+
+        OverloadMethodWrap findCachedOverload(int shapeLength)
+        {
+            for (int i = 0; i < SHAPE_CACHE_SIZE; ++i)
+            {
+                int[] shape = cachedShapes[i];
+                if (shape == null || cachedShapeLengths[i] != shapeLength)
+                {
+                    continue;
+                }
+                int j = 0;
+                while (j < shapeLength && shape[j] == argShape[j])
+                {
+                    ++j;
+                }
+                if (j == shapeLength)
+                {
+                    return cachedOverloads[i];
+                }
+            }
+            return null;
+        }
+
+        void cacheOverload(int shapeLength, OverloadMethodWrap overload)
+        {
+            for (int i = 0; i < shapeLength; ++i)
+            {
+                if ((argShape[i] & 0xF) == (int)LuaTypes.LUA_TUSERDATA && overload.translator.IsSharedTypeId(argShape[i] >> 4))
+                {
+                    return;
+                }
+            }
+            int slot = nextCacheSlot;
+            nextCacheSlot = (nextCacheSlot + 1) % SHAPE_CACHE_SIZE;
+            if (cachedShapes[slot] == null)
+            {
+                cachedShapes[slot] = new int[MAX_SHAPE_LENGTH];
+            }
+            Array.Copy(argShape, cachedShapes[slot], shapeLength);
+            cachedShapeLengths[slot] = shapeLength;
+            cachedOverloads[slot] = overload;
+        }
+
         public int Call(RealStatePtr L)
+        {
+            // wraps built without a type (the old constructor) are not counted
+            if (!ReflectionStats.Enabled || stat == null)
+            {
+                return call(L);
+            }
+            long start = System.Diagnostics.Stopwatch.GetTimestamp();
+            int ret = call(L);
+            stat.Record(start);
+            return ret;
+        }
+
+        int call(RealStatePtr L)
         {
             try
             {
                 if (overloads.Count == 1 && !overloads[0].HasDefalutValue && !forceCheck) return overloads[0].Call(L);
 
+                int shapeLength = LuaAPI.xlua_getargshape(L, 1, argShape, MAX_SHAPE_LENGTH);
+                if (shapeLength >= 0)
+                {
+                    OverloadMethodWrap cached = findCachedOverload(shapeLength);
+                    if (cached != null)
+                    {
+                        return cached.Call(L);
+                    }
+                }
+
                 for (int i = 0; i < overloads.Count; ++i)
                 {
                     var overload = overloads[i];
                     if (overload.Check(L))
                     {
+                        if (shapeLength >= 0)
+                        {
+                            cacheOverload(shapeLength, overload);
+                        }
                         return overload.Call(L);
                     }
                 }
@@ -552,7 +675,7 @@ namespace XLua
                 overload.Init(objCheckers, objCasters);
                 overloads.Add(overload);
             }
-            return new MethodWrap(methodName, overloads, forceCheck);
+            return new MethodWrap(type, methodName, overloads, forceCheck);
         }
 
         private static bool tryMakeGenericMethod(ref MethodBase method)
@@ -391,8 +391,7 @@ namespace XLua
             {
                 return null;
             }
-            LuaAPI.lua_pushvalue(L, idx);
-            return new LuaTable(LuaAPI.luaL_ref(L), translator.luaEnv);
+            return translator.GetLuaBase(L, idx, false);
         }
 
         private object getLuaFunction(RealStatePtr L, int idx, object target)
@@ -406,8 +405,7 @@ namespace XLua
             {
                 return null;
             }
-            LuaAPI.lua_pushvalue(L, idx);
-            return new LuaFunction(LuaAPI.luaL_ref(L), translator.luaEnv);
+            return translator.GetLuaBase(L, idx, true);
         }
 
         public void AddCaster(Type type, ObjectCast oc)
@@ -415,6 +413,36 @@ namespace XLua
             castersMap[type] = oc;
         }
 
+        delegate int RawGetArray<T>(RealStatePtr L, int idx, T[] buff, int len);
+
+        // numeric sequences are copied by one native call, return how many leading elements were read
+        static Func<RealStatePtr, int, Array, int, int> arrayBulkReader<T>(RawGetArray<T> rawget)
+        {
+            return (L, idx, ary, len) => rawget(L, idx, (T[])ary, len);
+        }
+
+        static Func<RealStatePtr, int, IList, int, int> listBulkReader<T>(RawGetArray<T> rawget)
+        {
+            return (L, idx, list, len) =>
+            {
+                T[] buff = new T[len];
+                int read = rawget(L, idx, buff, len);
+                List<T> typedList = (List<T>)list;
+                if (read == len)
+                {
+                    typedList.AddRange(buff);
+                }
+                else
+                {
+                    for (int i = 0; i < read; ++i)
+                    {
+                        typedList.Add(buff[i]);
+                    }
+                }
+                return read;
+            };
+        }
+
         private ObjectCast genCaster(Type type)
         {
             ObjectCast fixTypeGetter = (RealStatePtr L, int idx, object target) =>
@@ -492,6 +520,24 @@ namespace XLua
             }
             else if (type.IsArray)
             {
+                Func<RealStatePtr, int, Array, int, int> bulkReader = null;
+                if (type == typeof(double[]))
+                {
+                    bulkReader = arrayBulkReader<double>(LuaAPI.xlua_rawget_doubles);
+                }
+                else if (type == typeof(float[]))
+                {
+                    bulkReader = arrayBulkReader<float>(LuaAPI.xlua_rawget_floats);
+                }
+                else if (type == typeof(int[]))
+                {
+                    bulkReader = arrayBulkReader<int>(LuaAPI.xlua_rawget_ints);
+                }
+                else if (type == typeof(long[]))
+                {
+                    bulkReader = arrayBulkReader<long>(LuaAPI.xlua_rawget_longs);
+                }
+
                 return (RealStatePtr L, int idx, object target) =>
                 {
                     object obj = fixTypeGetter(L, idx, target);
@@ -512,20 +558,16 @@ namespace XLua
                     {
                         throw new Exception("stack overflow while cast to Array");
                     }
-                    for (int i = 0; i < len; ++i)
+                    int start = bulkReader == null ? 0 : bulkReader(L, idx, ary, Math.Min((int)len, ary.Length));
+                    ArrayAccessor accessor;
+                    translator.tryGetArrayAccessor(type, out accessor);
+                    for (int i = start; i < len; ++i)
                     {
                         LuaAPI.lua_pushnumber(L, i + 1);
                         LuaAPI.lua_rawget(L, idx);
-                        if (et.IsPrimitive())
+                        if (accessor == null || !accessor.TrySet(L, ary, i, n + 1))
                         {
-                            if (!StaticLuaCallbacks.TryPrimitiveArraySet(type, L, ary, i, n + 1))
-                            {
-                                ary.SetValue(elementCaster(L, n + 1, null), i);
-                            }
-                        }
-                        else
-                        {
-                            if (InternalGlobals.genTryArraySetPtr == null
+                            if (et.IsPrimitive() || InternalGlobals.genTryArraySetPtr == null
                                 || !InternalGlobals.genTryArraySetPtr(type, L, translator, ary, i, n + 1))
                             {
                                 ary.SetValue(elementCaster(L, n + 1, null), i);
@@ -540,6 +582,23 @@ namespace XLua
             {
                 Type elementType = type.GetGenericArguments()[0];
                 ObjectCast elementCaster = GetCaster(elementType);
+                Func<RealStatePtr, int, IList, int, int> bulkReader = null;
+                if (type == typeof(List<double>))
+                {
+                    bulkReader = listBulkReader<double>(LuaAPI.xlua_rawget_doubles);
+                }
+                else if (type == typeof(List<float>))
+                {
+                    bulkReader = listBulkReader<float>(LuaAPI.xlua_rawget_floats);
+                }
+                else if (type == typeof(List<int>))
+                {
+                    bulkReader = listBulkReader<int>(LuaAPI.xlua_rawget_ints);
+                }
+                else if (type == typeof(List<long>))
+                {
+                    bulkReader = listBulkReader<long>(LuaAPI.xlua_rawget_longs);
+                }
 
                 return (RealStatePtr L, int idx, object target) =>
                 {
@@ -562,7 +621,8 @@ namespace XLua
                     {
                         throw new Exception("stack overflow while cast to IList");
                     }
-                    for (int i = 0; i < len; ++i)
+                    int start = (bulkReader == null || list.Count != 0) ? 0 : bulkReader(L, idx, list, (int)len);
+                    for (int i = start; i < len; ++i)
                     {
                         LuaAPI.lua_pushnumber(L, i + 1);
                         LuaAPI.lua_rawget(L, idx);
@@ -455,23 +455,71 @@ namespace XLua
 
             throw new InvalidCastException("This type must add to CSharpCallLua: " + delegateType.GetFriendlyName());
         }
-        Dictionary<int, WeakReference> delegate_bridges = new Dictionary<int, WeakReference>();
-        public object CreateDelegateBridge(RealStatePtr L, Type delegateType, int idx)
+        class DelegateBridgeEntry
         {
-            LuaAPI.lua_pushvalue(L, idx);
-            LuaAPI.lua_rawget(L, LuaIndexes.LUA_REGISTRYINDEX);
-            if (!LuaAPI.lua_isnil(L, -1))
+            public WeakReference Bridge = new WeakReference(null);
+            public IntPtr Function;
+        }
+
+        // bridges by ref and refs by lua function address, the ref keeps the function alive so its address
+        // can not be taken by another function before the ref is released. entries are recycled on release
+        Dictionary<int, DelegateBridgeEntry> delegate_bridges = new Dictionary<int, DelegateBridgeEntry>();
+        Dictionary<IntPtr, int> delegate_functions = new Dictionary<IntPtr, int>();
+        Stack<DelegateBridgeEntry> delegate_entry_pool = new Stack<DelegateBridgeEntry>();
+
+        // strong references to the latest bridges (LuaEnv.DelegateBridgePoolSize), so rebinding a function whose
+        // delegate was just dropped finds its bridge and delegates still alive
+        DelegateBridgeBase[] delegate_bridge_pool = null;
+        int delegate_bridge_pool_next = 0;
+
+        internal DelegateBridgeStats delegateBridgeStats;
+
+        internal int DelegateBridgePoolSize
+        {
+            get
             {
-                int referenced = LuaAPI.xlua_tointeger(L, -1);
-                LuaAPI.lua_pop(L, 1);
+                return delegate_bridge_pool == null ? 0 : delegate_bridge_pool.Length;
+            }
+            set
+            {
+                if (value < 0)
+                {
+                    throw new ArgumentOutOfRangeException("value");
+                }
+                delegate_bridge_pool = value == 0 ? null : new DelegateBridgeBase[value];
+                delegate_bridge_pool_next = 0;
+            }
+        }
 
-                if (delegate_bridges[referenced].IsAlive)
+        internal void ClearDelegateBridgePool()
+        {
+            if (delegate_bridge_pool != null)
+            {
+                Array.Clear(delegate_bridge_pool, 0, delegate_bridge_pool.Length);
+                delegate_bridge_pool_next = 0;
+            }
+        }
+
+        public object CreateDelegateBridge(RealStatePtr L, Type delegateType, int idx)
+        {
+            IntPtr function = LuaAPI.lua_topointer(L, idx);
+            // nil, boolean, number and string have no address to identify them and can not be called
+            if (function == IntPtr.Zero)
+            {
+                return null;
+            }
+            int referenced;
+            if (delegate_functions.TryGetValue(function, out referenced))
+            {
+                DelegateBridgeBase exist_bridge = delegate_bridges[referenced].Bridge.Target as DelegateBridgeBase;
+                // a bridge collected but not released yet (see LuaEnv.Tick) keeps its ref, the mapping moves to the new one
+                if (exist_bridge != null)
                 {
+                    delegateBridgeStats.Reused++;
                     if (delegateType == null)
                     {
-                        return delegate_bridges[referenced].Target;
+                        return exist_bridge;
                     }
-                    DelegateBridgeBase exist_bridge = delegate_bridges[referenced].Target as DelegateBridgeBase;
                     Delegate exist_delegate;
                     if (exist_bridge.TryGetDelegate(delegateType, out exist_delegate))
                     {
@@ -481,20 +529,14 @@ namespace XLua
                     {
                         exist_delegate = getDelegate(exist_bridge, delegateType);
                         exist_bridge.AddDelegate(delegateType, exist_delegate);
+                        delegateBridgeStats.DelegatesCreated++;
                         return exist_delegate;
                     }
                 }
             }
-            else
-            {
-                LuaAPI.lua_pop(L, 1);
-            }
 
             LuaAPI.lua_pushvalue(L, idx);
             int reference = LuaAPI.luaL_ref(L);
-            LuaAPI.lua_pushvalue(L, idx);
-            LuaAPI.lua_pushnumber(L, reference);
-            LuaAPI.lua_rawset(L, LuaIndexes.LUA_REGISTRYINDEX);
             DelegateBridgeBase bridge;
             try
             {
@@ -511,36 +553,66 @@ namespace XLua
             }
             catch(Exception e)
             {
-                LuaAPI.lua_pushvalue(L, idx);
-                LuaAPI.lua_pushnil(L);
-                LuaAPI.lua_rawset(L, LuaIndexes.LUA_REGISTRYINDEX);
-                LuaAPI.lua_pushnil(L);
-                LuaAPI.xlua_rawseti(L, LuaIndexes.LUA_REGISTRYINDEX, reference);
+                LuaAPI.lua_unref(L, reference);
                 throw e;
             }
-            if (delegateType == null)
+            Delegate ret = null;
+            if (delegateType != null)
             {
-                delegate_bridges[reference] = new WeakReference(bridge);
-                return bridge;
+                try {
+                    ret = getDelegate(bridge, delegateType);
+                    bridge.AddDelegate(delegateType, ret);
+                    delegateBridgeStats.DelegatesCreated++;
+                }
+                catch(Exception e)
+                {
+                    bridge.Dispose();
+                    throw e;
+                }
             }
-            try {
-                var ret = getDelegate(bridge, delegateType);
-                bridge.AddDelegate(delegateType, ret);
-                delegate_bridges[reference] = new WeakReference(bridge);
-                return ret;
+            addDelegateBridge(function, reference, bridge);
+            return delegateType == null ? (object)bridge : ret;
+        }
+
+        void addDelegateBridge(IntPtr function, int reference, DelegateBridgeBase bridge)
+        {
+            var entry = delegate_entry_pool.Count > 0 ? delegate_entry_pool.Pop() : new DelegateBridgeEntry();
+            entry.Bridge.Target = bridge;
+            entry.Function = function;
+            delegate_bridges[reference] = entry;
+            delegate_functions[function] = reference;
+            delegateBridgeStats.Created++;
+            if (delegate_bridge_pool != null)
+            {
+                delegate_bridge_pool[delegate_bridge_pool_next] = bridge;
+                delegate_bridge_pool_next = (delegate_bridge_pool_next + 1) % delegate_bridge_pool.Length;
             }
-            catch(Exception e)
+        }
+
+        void releaseDelegateBridge(int reference)
+        {
+            DelegateBridgeEntry entry;
+            if (!delegate_bridges.TryGetValue(reference, out entry))
             {
-                bridge.Dispose();
-                throw e;
+                return;
+            }
+            delegate_bridges.Remove(reference);
+            int current;
+            //another Delegate ref the function before the GC tick
+            if (delegate_functions.TryGetValue(entry.Function, out current) && current == reference)
+            {
+                delegate_functions.Remove(entry.Function);
             }
+            entry.Bridge.Target = null;
+            delegate_entry_pool.Push(entry);
+            delegateBridgeStats.Released++;
         }
 
         public bool AllDelegateBridgeReleased()
         {
             foreach (var kv in delegate_bridges)
             {
-                if (kv.Value.IsAlive)
+                if (kv.Value.Bridge.IsAlive)
                 {
                     return false;
                 }
@@ -552,34 +624,47 @@ namespace XLua
         {
             if(is_delegate)
             {
-                LuaAPI.xlua_rawgeti(L, LuaIndexes.LUA_REGISTRYINDEX, reference);
-                if (LuaAPI.lua_isnil(L, -1))
-                {
-                    LuaAPI.lua_pop(L, 1);
-                }
-                else
+                releaseDelegateBridge(reference);
+                LuaAPI.lua_unref(L, reference);
+            }
+            else
+            {
+                releaseCachedLuaBase(L, reference);
+                LuaAPI.lua_unref(L, reference);
+            }
+        }
+
+        int[] releaseBuffer = new int[64];
+
+        // drains the queue of collected LuaBase objects: bookkeeping for all of them first, then one native call unrefs them
+        internal void ReleaseLuaBases(RealStatePtr L, Queue<LuaEnv.GCAction> queue)
+        {
+            int count = queue.Count;
+            if (releaseBuffer.Length < count)
+            {
+                releaseBuffer = new int[Math.Max(count, releaseBuffer.Length * 2)];
+            }
+            // a ref is recorded as soon as it is dequeued, so it is unreffed even if the bookkeeping throws
+            int dequeued = 0;
+            try
+            {
+                while (dequeued < count)
                 {
-                    LuaAPI.lua_pushvalue(L, -1);
-                    LuaAPI.lua_rawget(L, LuaIndexes.LUA_REGISTRYINDEX);
-                    if (LuaAPI.lua_type(L, -1) == LuaTypes.LUA_TNUMBER && LuaAPI.xlua_tointeger(L, -1) == reference) //
+                    var gca = queue.Dequeue();
+                    releaseBuffer[dequeued++] = gca.Reference;
+                    if (gca.IsDelegate)
                     {
-                        //UnityEngine.Debug.LogWarning("release delegate ref = " + luaReference);
-                        LuaAPI.lua_pop(L, 1);// pop LUA_REGISTRYINDEX[func]
-                        LuaAPI.lua_pushnil(L);
-                        LuaAPI.lua_rawset(L, LuaIndexes.LUA_REGISTRYINDEX); // LUA_REGISTRYINDEX[func] = nil
+                        releaseDelegateBridge(gca.Reference);
                     }
-                    else //another Delegate ref the function before the GC tick
+                    else
                     {
-                        LuaAPI.lua_pop(L, 2); // pop LUA_REGISTRYINDEX[func] & func
+                        releaseCachedLuaBase(L, gca.Reference);
                     }
                 }
-
-                LuaAPI.lua_unref(L, reference);
-                delegate_bridges.Remove(reference);
             }
-            else
+            finally
             {
-                LuaAPI.lua_unref(L, reference);
+                LuaAPI.xlua_unref_batch(L, releaseBuffer, dequeued);
             }
         }
 
@@ -614,6 +699,13 @@ namespace XLua
         }
 
         int common_delegate_meta = -1;
+
+        // arrays and delegates share a metatable, so their type id does not identify the c# type
+        internal bool IsSharedTypeId(int type_id)
+        {
+            return type_id == common_array_meta || type_id == common_delegate_meta;
+        }
+
         public void CreateDelegateMetatable(RealStatePtr L)
         {
             Utils.BeginObjectRegister(null, L, this, 3, 0, 0, 0, common_delegate_meta);
@@ -1146,7 +1238,7 @@ namespace XLua
             }
             else if (o is string)
             {
-                LuaAPI.lua_pushstring(L, o as string);
+                PushString(L, o as string);
             }
             else if (o is byte[])
             {
@@ -1519,7 +1611,7 @@ namespace XLua
                 {
                     {typeof(int),  new Action<RealStatePtr, int>(LuaAPI.xlua_pushinteger) },
                     {typeof(double), new Action<RealStatePtr, double>(LuaAPI.lua_pushnumber) },
-                    {typeof(string), new Action<RealStatePtr, string>(LuaAPI.lua_pushstring) },
+                    {typeof(string), new Action<RealStatePtr, string>(PushString) },
                     {typeof(byte[]), new Action<RealStatePtr, byte[]>(LuaAPI.lua_pushstring) },
                     {typeof(bool), new Action<RealStatePtr, bool>(LuaAPI.lua_pushboolean) },
                     {typeof(long), new Action<RealStatePtr, long>(LuaAPI.lua_pushint64) },
@@ -1594,6 +1686,45 @@ namespace XLua
         }
 
 
+        private Dictionary<Type, ArrayAccessor> array_accessors = null;
+
+        ArrayAccessor newArrayAccessor<T>(Func<RealStatePtr, int, bool> check)
+        {
+            Action<RealStatePtr, T> push;
+            Func<RealStatePtr, int, T> get;
+            tryGetPushFuncByType(typeof(T), out push);
+            tryGetGetFuncByType(typeof(T), out get);
+            return new ArrayAccessor<T>(push, get, check);
+        }
+
+        internal bool tryGetArrayAccessor(Type type, out ArrayAccessor accessor)
+        {
+            if (array_accessors == null)
+            {
+                Func<RealStatePtr, int, bool> isNumber = (L, idx) => LuaAPI.lua_type(L, idx) == LuaTypes.LUA_TNUMBER;
+                array_accessors = new Dictionary<Type, ArrayAccessor>()
+                {
+                    {typeof(int[]), newArrayAccessor<int>(isNumber) },
+                    {typeof(float[]), newArrayAccessor<float>(isNumber) },
+                    {typeof(double[]), newArrayAccessor<double>(isNumber) },
+                    {typeof(bool[]), newArrayAccessor<bool>((L, idx) => LuaAPI.lua_type(L, idx) == LuaTypes.LUA_TBOOLEAN) },
+                    {typeof(long[]), newArrayAccessor<long>(LuaAPI.lua_isint64) },
+                    {typeof(ulong[]), newArrayAccessor<ulong>(LuaAPI.lua_isuint64) },
+                    {typeof(byte[]), newArrayAccessor<byte>(isNumber) },
+                    {typeof(sbyte[]), newArrayAccessor<sbyte>(isNumber) },
+                    {typeof(short[]), newArrayAccessor<short>(isNumber) },
+                    {typeof(ushort[]), newArrayAccessor<ushort>(isNumber) },
+                    {typeof(char[]), newArrayAccessor<char>(isNumber) },
+                    {typeof(uint[]), newArrayAccessor<uint>(isNumber) },
+                    {typeof(IntPtr[]), newArrayAccessor<IntPtr>((L, idx) => LuaAPI.lua_type(L, idx) == LuaTypes.LUA_TLIGHTUSERDATA) },
+                    {typeof(decimal[]), newArrayAccessor<decimal>((L, idx) => LuaAPI.lua_type(L, idx) == LuaTypes.LUA_TNUMBER || IsDecimal(L, idx)) },
+                    {typeof(string[]), newArrayAccessor<string>((L, idx) => LuaAPI.lua_type(L, idx) == LuaTypes.LUA_TSTRING) },
+                };
+            }
+
+            return array_accessors.TryGetValue(type, out accessor);
+        }
+
         public delegate void GetFunc<T>(RealStatePtr L, int idx,  out T val);
 
         public void RegisterPushAndGetAndUpdate<T>(Action<RealStatePtr, T> push, GetFunc<T> get, Action<RealStatePtr, int, T> update)
@@ -1606,11 +1737,18 @@ namespace XLua
                 throw new InvalidOperationException("push or get of " + type + " has register!");
             }
             push_func_with_type.Add(type, push);
-            get_func_with_type.Add(type, new Func<RealStatePtr, int, T>((L, idx) => {
+            Func<RealStatePtr, int, T> typed_get = (L, idx) => {
                 T ret;
                 get(L, idx, out ret);
                 return ret;
-            }));
+            };
+            get_func_with_type.Add(type, typed_get);
+
+            ArrayAccessor org_accessor;
+            if (!tryGetArrayAccessor(typeof(T[]), out org_accessor))
+            {
+                array_accessors.Add(typeof(T[]), new ArrayAccessor<T>(push, typed_get, null));
+            }
 
             registerCustomOp(type, 
                 (RealStatePtr L, object obj) => {
@@ -1637,6 +1775,323 @@ namespace XLua
             });
         }
 
+        public delegate bool PackFunc<T>(IntPtr buff, int offset, T field);
+
+        public delegate bool UnPackFunc<T>(IntPtr buff, int offset, out T field);
+
+        class StructPacker<T>
+        {
+            public int Size;
+            public PackFunc<T> Pack;
+            public UnPackFunc<T> UnPack;
+        }
+
+        Dictionary<Type, object> struct_packers = new Dictionary<Type, object>();
+
+        public void RegisterStructPacker<T>(int size, PackFunc<T> pack, UnPackFunc<T> unpack)
+        {
+            struct_packers[typeof(T)] = new StructPacker<T>() { Size = size, Pack = pack, UnPack = unpack };
+        }
+
+        StructPacker<T> getStructPacker<T>()
+        {
+            object packer;
+            if (!struct_packers.TryGetValue(typeof(T), out packer))
+            {
+                throw new InvalidOperationException(typeof(T) + " is not a generated GCOptimize struct");
+            }
+            return (StructPacker<T>)packer;
+        }
+
+        // packs the whole array into one buffer userdata, read it in lua with xlua.genarrayaccessor(offset, tag, stride)
+        public void PushStructBuffer<T>(RealStatePtr L, T[] array)
+        {
+            StructPacker<T> packer = getStructPacker<T>();
+            IntPtr buff = LuaAPI.xlua_pushstructbuffer(L, (uint)(packer.Size * array.Length));
+            for (int i = 0; i < array.Length; ++i)
+            {
+                if (!packer.Pack(buff, i * packer.Size, array[i]))
+                {
+                    throw new Exception("pack fail for " + typeof(T) + " ,index=" + i);
+                }
+            }
+        }
+
+        public void GetStructBuffer<T>(RealStatePtr L, int index, T[] array)
+        {
+            StructPacker<T> packer = getStructPacker<T>();
+            if (LuaAPI.lua_type(L, index) != LuaTypes.LUA_TUSERDATA)
+            {
+                throw new Exception("struct buffer expected, got " + LuaAPI.lua_type(L, index));
+            }
+            IntPtr buff = LuaAPI.lua_touserdata(L, index);
+            // laid out as {int fake_id = -1; uint len; data} by xlua_pushstructbuffer
+            long size = (long)packer.Size * array.Length;
+            if (LuaAPI.xlua_objlen(L, index) < 8 || System.Runtime.InteropServices.Marshal.ReadInt32(buff) != -1
+                || (uint)System.Runtime.InteropServices.Marshal.ReadInt32(buff, 4) < size)
+            {
+                throw new Exception("struct buffer too small for " + array.Length + " " + typeof(T));
+            }
+            for (int i = 0; i < array.Length; ++i)
+            {
+                if (!packer.UnPack(buff, i * packer.Size, out array[i]))
+                {
+                    throw new Exception("unpack fail for " + typeof(T) + " ,index=" + i);
+                }
+            }
+        }
+
+        // reads t[1..len] of the table at index into dest, numbers and generated GCOptimize structs in one native
+        // loop up to the first element of another kind, the rest one by one
+        public void GetArrayPart<T>(RealStatePtr L, int index, T[] dest, int len)
+        {
+            index = index > 0 ? index : LuaAPI.lua_gettop(L) + index + 1;
+            int start = 0;
+            object packer;
+            if (typeof(T) == typeof(double))
+            {
+                start = LuaAPI.xlua_rawget_doubles(L, index, (double[])(object)dest, len);
+            }
+            else if (typeof(T) == typeof(float))
+            {
+                start = LuaAPI.xlua_rawget_floats(L, index, (float[])(object)dest, len);
+            }
+            else if (typeof(T) == typeof(int))
+            {
+                start = LuaAPI.xlua_rawget_ints(L, index, (int[])(object)dest, len);
+            }
+            else if (typeof(T) == typeof(long))
+            {
+                start = LuaAPI.xlua_rawget_longs(L, index, (long[])(object)dest, len);
+            }
+            else if (struct_packers.TryGetValue(typeof(T), out packer))
+            {
+                var structPacker = (StructPacker<T>)packer;
+                bool is_first;
+                int type_id = getTypeId(L, typeof(T), out is_first);
+                start = LuaAPI.xlua_rawget_structs(L, index, type_id, structPacker.Size, len);
+                IntPtr buff = LuaAPI.lua_touserdata(L, -1);
+                for (int i = 0; i < start; ++i)
+                {
+                    if (!structPacker.UnPack(buff, i * structPacker.Size, out dest[i]))
+                    {
+                        LuaAPI.lua_pop(L, 1);
+                        throw new Exception("unpack fail for " + typeof(T) + " ,index=" + i);
+                    }
+                }
+                LuaAPI.lua_pop(L, 1);
+            }
+
+            for (int i = start; i < len; ++i)
+            {
+                LuaAPI.xlua_rawgeti(L, index, i + 1);
+                try
+                {
+                    Get(L, -1, out dest[i]);
+                }
+                finally
+                {
+                    LuaAPI.lua_pop(L, 1);
+                }
+            }
+        }
+
+        // writes src[0..len) to t[1..len] of the table at index, numbers in one native loop, the rest one by one
+        public void SetArrayPart<T>(RealStatePtr L, int index, T[] src, int len)
+        {
+            index = index > 0 ? index : LuaAPI.lua_gettop(L) + index + 1;
+            if (typeof(T) == typeof(double))
+            {
+                LuaAPI.xlua_rawset_doubles(L, index, (double[])(object)src, len);
+            }
+            else if (typeof(T) == typeof(float))
+            {
+                LuaAPI.xlua_rawset_floats(L, index, (float[])(object)src, len);
+            }
+            else if (typeof(T) == typeof(int))
+            {
+                LuaAPI.xlua_rawset_ints(L, index, (int[])(object)src, len);
+            }
+            else if (typeof(T) == typeof(long))
+            {
+                LuaAPI.xlua_rawset_longs(L, index, (long[])(object)src, len);
+            }
+            else
+            {
+                for (int i = 0; i < len; ++i)
+                {
+                    PushByType(L, src[i]);
+                    LuaAPI.xlua_rawseti(L, index, i + 1);
+                }
+            }
+        }
+
+        // string instance -> registry ref of the lua string, null when the cache is off
+        Dictionary<object, int> stringCache = null;
+        int stringCacheSize = 0;
+
+        internal int StringCacheSize
+        {
+            get
+            {
+                return stringCacheSize;
+            }
+            set
+            {
+                ReleaseStringCache(luaEnv.L);
+                stringCacheSize = value;
+                stringCache = value > 0 ? new Dictionary<object, int>(new ReferenceEqualsComparer()) : null;
+            }
+        }
+
+        void ReleaseStringCache(RealStatePtr L)
+        {
+            if (stringCache == null)
+            {
+                return;
+            }
+            foreach (var reference in stringCache.Values)
+            {
+                LuaAPI.lua_unref(L, reference);
+            }
+            stringCache.Clear();
+        }
+
+        public void PushString(RealStatePtr L, string str)
+        {
+            if (stringCache == null || str == null)
+            {
+                LuaAPI.lua_pushstring(L, str);
+                return;
+            }
+
+            int reference;
+            if (stringCache.TryGetValue(str, out reference))
+            {
+                LuaAPI.lua_getref(L, reference);
+                return;
+            }
+
+            if (stringCache.Count >= stringCacheSize)
+            {
+                ReleaseStringCache(L);
+            }
+            LuaAPI.lua_pushstring(L, str);
+            LuaAPI.lua_pushvalue(L, -1);
+            stringCache.Add(str, LuaAPI.luaL_ref(L));
+        }
+
+        // lua table/function -> ref of the LuaBase wrapping it, in a weak keyed lua table, and ref -> that wrapper,
+        // so fetching the same object again while its wrapper is alive costs neither a ref nor a finalizable object.
+        // null when the cache is off
+        Dictionary<int, WeakReference> luaBaseCache = null;
+        int luaBaseCacheRef = -1;
+
+        internal bool LuaBaseCacheEnabled
+        {
+            get
+            {
+                return luaBaseCache != null;
+            }
+            set
+            {
+                var L = luaEnv.L;
+                if (value && luaBaseCache == null)
+                {
+                    LuaAPI.lua_newtable(L);
+                    LuaAPI.lua_newtable(L);
+                    LuaAPI.xlua_pushasciistring(L, "__mode");
+                    LuaAPI.xlua_pushasciistring(L, "k");
+                    LuaAPI.lua_rawset(L, -3);
+                    LuaAPI.lua_setmetatable(L, -2);
+                    luaBaseCacheRef = LuaAPI.luaL_ref(L);
+                    luaBaseCache = new Dictionary<int, WeakReference>();
+                }
+                else if (!value && luaBaseCache != null)
+                {
+                    // wrappers already handed out keep their refs and release them as usual
+                    LuaAPI.lua_unref(L, luaBaseCacheRef);
+                    luaBaseCacheRef = -1;
+                    luaBaseCache = null;
+                }
+            }
+        }
+
+        internal LuaBase GetLuaBase(RealStatePtr L, int idx, bool isFunction)
+        {
+            if (luaBaseCache == null)
+            {
+                LuaAPI.lua_pushvalue(L, idx);
+                return createLuaBase(LuaAPI.luaL_ref(L), isFunction);
+            }
+
+            idx = idx > 0 ? idx : LuaAPI.lua_gettop(L) + idx + 1;
+            LuaAPI.lua_getref(L, luaBaseCacheRef);
+            LuaAPI.lua_pushvalue(L, idx);
+            LuaAPI.lua_rawget(L, -2);
+            if (LuaAPI.lua_type(L, -1) == LuaTypes.LUA_TNUMBER)
+            {
+                WeakReference cached;
+                if (luaBaseCache.TryGetValue(LuaAPI.xlua_tointeger(L, -1), out cached))
+                {
+                    var target = cached.Target as LuaBase;
+                    if (target != null)
+                    {
+                        LuaAPI.lua_pop(L, 2);
+                        return target;
+                    }
+                }
+            }
+            LuaAPI.lua_pop(L, 1);
+
+            // a wrapper collected but not released yet (see LuaEnv.Tick) keeps its ref, the mapping moves to the new one
+            LuaAPI.lua_pushvalue(L, idx);
+            int reference = LuaAPI.luaL_ref(L);
+            LuaAPI.lua_pushvalue(L, idx);
+            LuaAPI.xlua_pushinteger(L, reference);
+            LuaAPI.lua_rawset(L, -3);
+            LuaAPI.lua_pop(L, 1);
+            var luaBase = createLuaBase(reference, isFunction);
+            luaBaseCache[reference] = new WeakReference(luaBase);
+            return luaBase;
+        }
+
+        LuaBase createLuaBase(int reference, bool isFunction)
+        {
+            var luaBase = isFunction ? (LuaBase)new LuaFunction(reference, luaEnv) : new LuaTable(reference, luaEnv);
+            var scope = luaEnv.refScope;
+            if (scope != null && scope.OwnerThreadId == System.Threading.Thread.CurrentThread.ManagedThreadId)
+            {
+                // released by LuaEnv.endRefScope
+                GC.SuppressFinalize(luaBase);
+                scope.Objects.Add(luaBase);
+            }
+            return luaBase;
+        }
+
+        void releaseCachedLuaBase(RealStatePtr L, int reference)
+        {
+            if (luaBaseCache == null || !luaBaseCache.Remove(reference))
+            {
+                return;
+            }
+            LuaAPI.lua_getref(L, luaBaseCacheRef);
+            LuaAPI.lua_getref(L, reference);
+            LuaAPI.lua_pushvalue(L, -1);
+            LuaAPI.lua_rawget(L, -3);
+            if (LuaAPI.lua_type(L, -1) == LuaTypes.LUA_TNUMBER && LuaAPI.xlua_tointeger(L, -1) == reference)
+            {
+                LuaAPI.lua_pop(L, 1);
+                LuaAPI.lua_pushnil(L);
+                LuaAPI.lua_rawset(L, -3);
+                LuaAPI.lua_pop(L, 1);
+            }
+            else
+            {
+                LuaAPI.lua_pop(L, 3);
+            }
+        }
+
         int decimal_type_id = -1;
 
         public void PushDecimal(RealStatePtr L, decimal val)
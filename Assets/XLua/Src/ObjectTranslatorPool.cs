@@ -25,9 +25,15 @@ namespace XLua
 	{
 #if !SINGLE_ENV
         private Dictionary<RealStatePtr, WeakReference> translators = new Dictionary<RealStatePtr, WeakReference>();
-        RealStatePtr lastPtr = default(RealStatePtr);
-#endif
+
+        // slot of each live translator, the slot index is kept in the native lua state (xlua_settranslatorindex),
+        // so Find is a native call plus an array read, no lock or dictionary lookup;
+        // the array is copied on write so readers on other threads always see a complete one,
+        // volatile so the lock free read in Find sees the latest array on weak memory models (il2cpp on arm)
+        private volatile ObjectTranslator[] indexedTranslators = new ObjectTranslator[4];
+#else
         ObjectTranslator lastTranslator = default(ObjectTranslator);
+#endif
 
         public static ObjectTranslatorPool Instance
 		{
@@ -48,49 +54,57 @@ namespace XLua
 		{
 		}
 		
+		// envs may be created and disposed on any thread (LuaWorkerPool), that is rare enough to always lock
 		public void Add (RealStatePtr L, ObjectTranslator translator)
 		{
-#if THREAD_SAFE || HOTFIX_ENABLE
             lock (this)
-#endif
             {
-                lastTranslator = translator;
 #if !SINGLE_ENV
                 var ptr = LuaAPI.xlua_gl(L);
-                lastPtr = ptr;
                 translators.Add(ptr , new WeakReference(translator));
+                int index = Array.IndexOf(indexedTranslators, null);
+                var newIndexed = new ObjectTranslator[index < 0 ? indexedTranslators.Length * 2 : indexedTranslators.Length];
+                Array.Copy(indexedTranslators, newIndexed, indexedTranslators.Length);
+                if (index < 0) index = indexedTranslators.Length;
+                if (LuaAPI.xlua_settranslatorindex(L, index))
+                {
+                    newIndexed[index] = translator;
+                    indexedTranslators = newIndexed;
+                }
+#else
+                lastTranslator = translator;
 #endif
             }
         }
 
 		public ObjectTranslator Find (RealStatePtr L)
 		{
-#if THREAD_SAFE || HOTFIX_ENABLE
-            lock (this)
-#endif
-            {
 #if SINGLE_ENV
-                return lastTranslator;
+            return lastTranslator;
 #else
-                var ptr = LuaAPI.xlua_gl(L);
-                if (lastPtr == ptr) return lastTranslator;
-                if (translators.ContainsKey(ptr))
+            int index = LuaAPI.xlua_gettranslatorindex(L);
+            var indexed = indexedTranslators;
+            if (index >= 0 && index < indexed.Length && indexed[index] != null)
+            {
+                return indexed[index];
+            }
+            lock (this)
+            {
+                // envs beyond the native slot limit (luajit/5.1 only)
+                WeakReference weakRef;
+                if (translators.TryGetValue(LuaAPI.xlua_gl(L), out weakRef))
                 {
-                    lastPtr = ptr;
-                    lastTranslator = translators[ptr].Target as ObjectTranslator;
-                    return lastTranslator;
+                    return weakRef.Target as ObjectTranslator;
                 }
                 
                 return null;
-#endif
             }
+#endif
         }
 		
 		public void Remove (RealStatePtr L)
 		{
-#if THREAD_SAFE || HOTFIX_ENABLE
             lock (this)
-#endif
             {
 #if SINGLE_ENV
                 lastTranslator = default(ObjectTranslator);
@@ -99,11 +113,14 @@ namespace XLua
                 if (!translators.ContainsKey (ptr))
                     return;
                 
-                if (lastPtr == ptr)
+                int index = LuaAPI.xlua_gettranslatorindex(L);
+                if (index >= 0 && index < indexedTranslators.Length)
                 {
-                    lastPtr = default(RealStatePtr);
-                    lastTranslator = default(ObjectTranslator);
+                    var newIndexed = (ObjectTranslator[])indexedTranslators.Clone();
+                    newIndexed[index] = null;
+                    indexedTranslators = newIndexed;
                 }
+                LuaAPI.xlua_settranslatorindex(L, -1);
 
                 translators.Remove(ptr);
 #endif
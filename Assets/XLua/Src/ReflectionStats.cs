@@ -0,0 +1,151 @@
+﻿/*
+ * Tencent is pleased to support the open source community by making xLua available.
+ * Copyright (C) 2016 THL A29 Limited, a Tencent company. All rights reserved.
+ * Licensed under the MIT License (the "License"); you may not use this file except in compliance with the License. You may obtain a copy of the License at
+ * http://opensource.org/licenses/MIT
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the specific language governing permissions and limitations under the License.
+*/
+
+using System.Collections.Generic;
+using System;
+using System.Diagnostics;
+using System.Linq;
+using System.Text;
+using System.Threading;
+
+namespace XLua
+{
+    public class ReflectionCallStat
+    {
+        public Type Type { get; private set; }
+
+        public string Member { get; private set; }
+
+        internal long calls = 0;
+        internal long ticks = 0;
+
+        internal ReflectionCallStat(Type type, string member)
+        {
+            Type = type;
+            Member = member;
+        }
+
+        public long Calls
+        {
+            get
+            {
+                return Interlocked.Read(ref calls);
+            }
+        }
+
+        public double Milliseconds
+        {
+            get
+            {
+                return Interlocked.Read(ref ticks) * 1000.0 / Stopwatch.Frequency;
+            }
+        }
+
+        internal void Record(long startTimestamp)
+        {
+            Interlocked.Increment(ref calls);
+            Interlocked.Add(ref ticks, Stopwatch.GetTimestamp() - startTimestamp);
+        }
+    }
+
+    // counts calls which reached c# through reflection (types not in the generate list),
+    // ExportGenConfig turns the hottest ones into a LuaCallCSharp config for the generator
+    public static class ReflectionStats
+    {
+        public static bool Enabled = false;
+
+        static Dictionary<Type, Dictionary<string, ReflectionCallStat>> stats = new Dictionary<Type, Dictionary<string, ReflectionCallStat>>();
+
+        internal static ReflectionCallStat GetStat(Type type, string member)
+        {
+            lock (stats)
+            {
+                Dictionary<string, ReflectionCallStat> members;
+                if (!stats.TryGetValue(type, out members))
+                {
+                    members = new Dictionary<string, ReflectionCallStat>();
+                    stats.Add(type, members);
+                }
+                ReflectionCallStat stat;
+                if (!members.TryGetValue(member, out stat))
+                {
+                    stat = new ReflectionCallStat(type, member);
+                    members.Add(member, stat);
+                }
+                return stat;
+            }
+        }
+
+        // members which have been called, most expensive first
+        public static List<ReflectionCallStat> GetStats()
+        {
+            lock (stats)
+            {
+                return stats.Values.SelectMany(members => members.Values).Where(stat => stat.Calls > 0)
+                    .OrderByDescending(stat => stat.Milliseconds).ToList();
+            }
+        }
+
+        // types which can be added to LuaCallCSharp, ordered by cumulative time spent in reflection calls
+        public static List<Type> GetHotTypes(int topN)
+        {
+            return GetStats().Where(stat => isGeneratable(stat.Type)).GroupBy(stat => stat.Type)
+                .OrderByDescending(group => group.Sum(stat => stat.Milliseconds))
+                .Take(topN).Select(group => group.Key).ToList();
+        }
+
+        public static void Reset()
+        {
+            lock (stats)
+            {
+                foreach (var stat in stats.Values.SelectMany(members => members.Values))
+                {
+                    Interlocked.Exchange(ref stat.calls, 0);
+                    Interlocked.Exchange(ref stat.ticks, 0);
+                }
+            }
+        }
+
+        // c# source of a generate config for the topN hot types, drop it in an Editor folder and regenerate
+        public static string ExportGenConfig(int topN, string className = "ReflectionHotTypesGenConfig")
+        {
+            var hotStats = GetStats();
+            var hotTypes = GetHotTypes(topN);
+
+            StringBuilder sb = new StringBuilder();
+            sb.AppendLine("using System;");
+            sb.AppendLine("using System.Collections.Generic;");
+            sb.AppendLine("using XLua;");
+            sb.AppendLine();
+            sb.AppendLine("public static class " + className);
+            sb.AppendLine("{");
+            sb.AppendLine("    [LuaCallCSharp]");
+            sb.AppendLine("    public static List<Type> LuaCallCSharp = new List<Type>()");
+            sb.AppendLine("    {");
+            foreach (var type in hotTypes)
+            {
+                var typeStats = hotStats.Where(stat => stat.Type == type).ToList();
+                sb.AppendLine(string.Format("        typeof({0}), // {1} calls, {2:0.###}ms, hottest: {3}", typeName(type),
+                    typeStats.Sum(stat => stat.Calls), typeStats.Sum(stat => stat.Milliseconds), typeStats[0].Member));
+            }
+            sb.AppendLine("    };");
+            sb.AppendLine("}");
+            return sb.ToString();
+        }
+
+        static bool isGeneratable(Type type)
+        {
+            return Utils.IsPublic(type) && !type.IsArray && !type.IsGenericTypeDefinition() && !typeof(Delegate).IsAssignableFrom(type);
+        }
+
+        static string typeName(Type type)
+        {
+            return type.GetFriendlyName().Replace('+', '.');
+        }
+    }
+}
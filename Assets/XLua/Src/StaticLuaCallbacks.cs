@@ -248,88 +248,6 @@ namespace XLua
             }
         }
 
-        static bool tryPrimitiveArrayGet(Type type, RealStatePtr L, object obj, int index)
-        {
-            bool ok = true;
-
-            if (type == typeof(int[]))
-            {
-                int[] array = obj as int[];
-                LuaAPI.xlua_pushinteger(L, array[index]);
-            }
-            else if (type == typeof(float[]))
-            {
-                float[] array = obj as float[];
-                LuaAPI.lua_pushnumber(L, array[index]);
-            }
-            else if (type == typeof(double[]))
-            {
-                double[] array = obj as double[];
-                LuaAPI.lua_pushnumber(L, array[index]);
-            }
-            else if (type == typeof(bool[]))
-            {
-                bool[] array = obj as bool[];
-                LuaAPI.lua_pushboolean(L, array[index]);
-            }
-            else if (type == typeof(long[]))
-            {
-                long[] array = obj as long[];
-                LuaAPI.lua_pushint64(L, array[index]);
-            }
-            else if (type == typeof(ulong[]))
-            {
-                ulong[] array = obj as ulong[];
-                LuaAPI.lua_pushuint64(L, array[index]);
-            }
-            else if (type == typeof(sbyte[]))
-            {
-                sbyte[] array = obj as sbyte[];
-                LuaAPI.xlua_pushinteger(L, array[index]);
-            }
-            else if (type == typeof(short[]))
-            {
-                short[] array = obj as short[];
-                LuaAPI.xlua_pushinteger(L, array[index]);
-            }
-            else if (type == typeof(ushort[]))
-            {
-                ushort[] array = obj as ushort[];
-                LuaAPI.xlua_pushinteger(L, array[index]);
-            }
-            else if (type == typeof(char[]))
-            {
-                char[] array = obj as char[];
-                LuaAPI.xlua_pushinteger(L, array[index]);
-            }
-            else if (type == typeof(uint[]))
-            {
-                uint[] array = obj as uint[];
-                LuaAPI.xlua_pushuint(L, array[index]);
-            }
-            else if (type == typeof(IntPtr[]))
-            {
-                IntPtr[] array = obj as IntPtr[];
-                LuaAPI.lua_pushlightuserdata(L, array[index]);
-            }
-            else if (type == typeof(decimal[]))
-            {
-                decimal[] array = obj as decimal[];
-                ObjectTranslator translator = ObjectTranslatorPool.Instance.Find(L);
-                translator.PushDecimal(L, array[index]);
-            }
-            else if (type == typeof(string[]))
-            {
-                string[] array = obj as string[];
-                LuaAPI.lua_pushstring(L, array[index]);
-            }
-            else
-            {
-                ok = false;
-            }
-            return ok;
-        }
-
 #if GEN_CODE_MINIMIZE
         public static int ArrayIndexer(RealStatePtr L, int top)
 #else
@@ -355,8 +273,10 @@ namespace XLua
                 }
 
                 Type type = array.GetType();
-                if (tryPrimitiveArrayGet(type, L, array, i))
+                ArrayAccessor accessor;
+                if (translator.tryGetArrayAccessor(type, out accessor))
                 {
+                    accessor.Get(L, array, i);
                     return 1;
                 }
 
@@ -389,105 +309,9 @@ namespace XLua
 
         public static bool TryPrimitiveArraySet(Type type, RealStatePtr L, object obj, int array_idx, int obj_idx)
         {
-            bool ok = true;
-
-            LuaTypes lua_type = LuaAPI.lua_type(L, obj_idx);
-
-            if (type == typeof(int[]) && lua_type == LuaTypes.LUA_TNUMBER)
-            {
-                int[] array = obj as int[];
-                array[array_idx] = LuaAPI.xlua_tointeger(L, obj_idx);
-            }
-            else if (type == typeof(float[]) && lua_type == LuaTypes.LUA_TNUMBER)
-            {
-                float[] array = obj as float[];
-                array[array_idx] = (float)LuaAPI.lua_tonumber(L, obj_idx);
-            }
-            else if (type == typeof(double[]) && lua_type == LuaTypes.LUA_TNUMBER)
-            {
-                double[] array = obj as double[];
-                array[array_idx] = LuaAPI.lua_tonumber(L, obj_idx); ;
-            }
-            else if (type == typeof(bool[]) && lua_type == LuaTypes.LUA_TBOOLEAN)
-            {
-                bool[] array = obj as bool[];
-                array[array_idx] = LuaAPI.lua_toboolean(L, obj_idx);
-            }
-            else if (type == typeof(long[]) && LuaAPI.lua_isint64(L, obj_idx))
-            {
-                long[] array = obj as long[];
-                array[array_idx] = LuaAPI.lua_toint64(L, obj_idx);
-            }
-            else if (type == typeof(ulong[]) && LuaAPI.lua_isuint64(L, obj_idx))
-            {
-                ulong[] array = obj as ulong[];
-                array[array_idx] = LuaAPI.lua_touint64(L, obj_idx);
-            }
-            else if (type == typeof(sbyte[]) && lua_type == LuaTypes.LUA_TNUMBER)
-            {
-                sbyte[] array = obj as sbyte[];
-                array[array_idx] = (sbyte)LuaAPI.xlua_tointeger(L, obj_idx);
-            }
-            else if (type == typeof(short[]) && lua_type == LuaTypes.LUA_TNUMBER)
-            {
-                short[] array = obj as short[];
-                array[array_idx] = (short)LuaAPI.xlua_tointeger(L, obj_idx);
-            }
-            else if (type == typeof(ushort[]) && lua_type == LuaTypes.LUA_TNUMBER)
-            {
-                ushort[] array = obj as ushort[];
-                array[array_idx] = (ushort)LuaAPI.xlua_tointeger(L, obj_idx);
-            }
-            else if (type == typeof(char[]) && lua_type == LuaTypes.LUA_TNUMBER)
-            {
-                char[] array = obj as char[];
-                array[array_idx] = (char)LuaAPI.xlua_tointeger(L, obj_idx);
-            }
-            else if (type == typeof(uint[]) && lua_type == LuaTypes.LUA_TNUMBER)
-            {
-                uint[] array = obj as uint[];
-                array[array_idx] = LuaAPI.xlua_touint(L, obj_idx);
-            }
-            else if (type == typeof(IntPtr[]) && lua_type == LuaTypes.LUA_TLIGHTUSERDATA)
-            {
-                IntPtr[] array = obj as IntPtr[];
-                array[array_idx] = LuaAPI.lua_touserdata(L, obj_idx);
-            }
-            else if (type == typeof(decimal[]))
-            {
-                decimal[] array = obj as decimal[];
-                if (lua_type == LuaTypes.LUA_TNUMBER)
-                {
-                    array[array_idx] = (decimal)LuaAPI.lua_tonumber(L, obj_idx);
-                }
-
-                if (lua_type == LuaTypes.LUA_TUSERDATA)
-                {
-                    ObjectTranslator translator = ObjectTranslatorPool.Instance.Find(L);
-                    if (translator.IsDecimal(L, obj_idx))
-                    {
-                        translator.Get(L, obj_idx, out array[array_idx]);
-                    }
-                    else
-                    {
-                        ok = false;
-                    }
-                }
-                else
-                {
-                    ok = false;
-                }
-            }
-            else if (type == typeof(string[]) && lua_type == LuaTypes.LUA_TSTRING)
-            {
-                string[] array = obj as string[];
-                array[array_idx] = LuaAPI.lua_tostring(L, obj_idx);
-            }
-            else
-            {
-                ok = false;
-            }
-            return ok;
+            ObjectTranslator translator = ObjectTranslatorPool.Instance.Find(L);
+            ArrayAccessor accessor;
+            return translator.tryGetArrayAccessor(type, out accessor) && accessor.TrySet(L, obj, array_idx, obj_idx);
         }
 
 #if GEN_CODE_MINIMIZE
@@ -515,7 +339,8 @@ namespace XLua
                 }
 
                 Type type = array.GetType();
-                if (TryPrimitiveArraySet(type, L, array, i, 3))
+                ArrayAccessor accessor;
+                if (translator.tryGetArrayAccessor(type, out accessor) && accessor.TrySet(L, array, i, 3))
                 {
                     return 0;
                 }
@@ -771,6 +596,38 @@ namespace XLua
         }
 #endif
 
+        [MonoPInvokeCallback(typeof(LuaCSFunction))]
+        internal static int LoadFromModuleImages(RealStatePtr L)
+        {
+            try
+            {
+                string filename = LuaAPI.lua_tostring(L, 1);
+
+                LuaEnv self = ObjectTranslatorPool.Instance.Find(L).luaEnv;
+
+                foreach (var image in self.moduleImages)
+                {
+                    byte[] bytecode = image.Get(filename);
+                    if (bytecode != null)
+                    {
+                        if (LuaAPI.xluaL_loadbuffer(L, bytecode, bytecode.Length, "@" + filename) != 0)
+                        {
+                            return LuaAPI.luaL_error(L, String.Format("error loading module {0} from LuaModuleImage, {1}",
+                                LuaAPI.lua_tostring(L, 1), LuaAPI.lua_tostring(L, -1)));
+                        }
+                        return 1;
+                    }
+                }
+                LuaAPI.lua_pushstring(L, string.Format(
+                    "\n\tno such module '{0}' in LuaModuleImages!", filename));
+                return 1;
+            }
+            catch (System.Exception e)
+            {
+                return LuaAPI.luaL_error(L, "c# exception in LoadFromModuleImages:" + e);
+            }
+        }
+
         [MonoPInvokeCallback(typeof(LuaCSFunction))]
         internal static int LoadFromCustomLoaders(RealStatePtr L)
         {
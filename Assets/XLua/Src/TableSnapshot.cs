@@ -0,0 +1,330 @@
+﻿/*
+ * Tencent is pleased to support the open source community by making xLua available.
+ * Copyright (C) 2016 THL A29 Limited, a Tencent company. All rights reserved.
+ * Licensed under the MIT License (the "License"); you may not use this file except in compliance with the License. You may obtain a copy of the License at
+ * http://opensource.org/licenses/MIT
+ * Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the License for the specific language governing permissions and limitations under the License.
+*/
+
+#if USE_UNI_LUA
+using LuaAPI = UniLua.Lua;
+using RealStatePtr = UniLua.ILuaState;
+using LuaCSFunction = UniLua.CSharpFunctionDelegate;
+#else
+using LuaAPI = XLua.LuaDLL.Lua;
+using RealStatePtr = System.IntPtr;
+using LuaCSFunction = XLua.LuaDLL.lua_CSFunction;
+#endif
+
+using System;
+using System.Collections;
+using System.Collections.Generic;
+using System.Reflection;
+using System.Runtime.InteropServices;
+using System.Text;
+
+namespace XLua
+{
+    // reads a whole table into a c# object graph with one native walk (LuaTable.Snapshot<T>).
+    // the layout of a type (public instance fields, like LuaTable.Cast) is turned into a schema table once per env,
+    // xlua_snapshot fills a flat buffer following it and the buffer is decoded here without touching lua again
+    internal class TableSnapshot
+    {
+        // keep in sync with SNAPSHOT_* in xlua.c
+        enum Kind
+        {
+            Boolean = 1,
+            Integer = 2,
+            Number = 3,
+            String = 4,
+            Object = 5,
+            Array = 6,
+        }
+
+        class Layout
+        {
+            public Type Type;
+            public Kind Kind;
+            public TypeCode TypeCode;
+            public FieldInfo[] Fields;
+            public Layout[] FieldLayouts;
+            public Layout Element;
+            public bool IsList;
+        }
+
+        static Dictionary<Type, Layout> layouts = new Dictionary<Type, Layout>();
+
+        static Layout getLayout(Type type)
+        {
+            lock (layouts)
+            {
+                return getLayoutLocked(type);
+            }
+        }
+
+        static Layout getLayoutLocked(Type type)
+        {
+            Layout layout;
+            if (layouts.TryGetValue(type, out layout))
+            {
+                return layout;
+            }
+            layout = new Layout() { Type = type, TypeCode = Type.GetTypeCode(type.IsEnum() ? Enum.GetUnderlyingType(type) : type) };
+            switch (layout.TypeCode)
+            {
+                case TypeCode.Boolean:
+                    layout.Kind = Kind.Boolean;
+                    break;
+                case TypeCode.Char:
+                case TypeCode.SByte:
+                case TypeCode.Byte:
+                case TypeCode.Int16:
+                case TypeCode.UInt16:
+                case TypeCode.Int32:
+                case TypeCode.UInt32:
+                case TypeCode.Int64:
+                case TypeCode.UInt64:
+                    layout.Kind = Kind.Integer;
+                    break;
+                case TypeCode.Single:
+                case TypeCode.Double:
+                    layout.Kind = Kind.Number;
+                    break;
+                case TypeCode.String:
+                    layout.Kind = Kind.String;
+                    break;
+                default:
+                    if (type.IsArray && type.GetArrayRank() == 1)
+                    {
+                        layout.Kind = Kind.Array;
+                    }
+                    else if (type.IsGenericType() && type.GetGenericTypeDefinition() == typeof(List<>))
+                    {
+                        layout.Kind = Kind.Array;
+                        layout.IsList = true;
+                    }
+                    else if (layout.TypeCode == TypeCode.Object && type != typeof(object) && Nullable.GetUnderlyingType(type) == null
+                        && ((type.IsClass() && !type.IsAbstract() && type.GetConstructor(Type.EmptyTypes) != null) || type.IsValueType()))
+                    {
+                        layout.Kind = Kind.Object;
+                    }
+                    else
+                    {
+                        throw new LuaException(type.GetFriendlyName() + " can not be snapshotted");
+                    }
+                    break;
+            }
+
+            // registered before the members, so recursive types terminate
+            layouts.Add(type, layout);
+            try
+            {
+                if (layout.Kind == Kind.Array)
+                {
+                    layout.Element = getLayoutLocked(layout.IsList ? type.GetGenericArguments()[0] : type.GetElementType());
+                }
+                else if (layout.Kind == Kind.Object)
+                {
+                    var fields = type.GetFields(BindingFlags.Instance | BindingFlags.Public);
+                    layout.Fields = fields;
+                    layout.FieldLayouts = new Layout[fields.Length];
+                    for (int i = 0; i < fields.Length; i++)
+                    {
+                        layout.FieldLayouts[i] = getLayoutLocked(fields[i].FieldType);
+                    }
+                }
+            }
+            catch
+            {
+                layouts.Remove(type);
+                throw;
+            }
+            return layout;
+        }
+
+        LuaEnv luaEnv;
+        Dictionary<Type, int> schemaRefs = new Dictionary<Type, int>();
+        Dictionary<Type, int> fieldsRefs = new Dictionary<Type, int>();
+
+        internal TableSnapshot(LuaEnv luaEnv)
+        {
+            this.luaEnv = luaEnv;
+        }
+
+        // the descriptor of a whole value of type, called with the env locked
+        internal int GetSchemaRef(Type type)
+        {
+            int reference;
+            if (!schemaRefs.TryGetValue(type, out reference))
+            {
+                var L = luaEnv.L;
+                pushDescriptor(L, null, getLayout(type));
+                reference = LuaAPI.luaL_ref(L);
+                schemaRefs.Add(type, reference);
+            }
+            return reference;
+        }
+
+        void pushDescriptor(RealStatePtr L, string key, Layout layout)
+        {
+            if (!LuaAPI.lua_checkstack(L, 4))
+            {
+                throw new LuaException("stack overflow while building snapshot schema of " + layout.Type);
+            }
+            LuaAPI.lua_createtable(L, 3, 0);
+            if (key == null)
+            {
+                LuaAPI.lua_pushboolean(L, false);
+            }
+            else
+            {
+                LuaAPI.lua_pushstring(L, key);
+            }
+            LuaAPI.xlua_rawseti(L, -2, 1);
+            LuaAPI.xlua_pushinteger(L, (int)layout.Kind);
+            LuaAPI.xlua_rawseti(L, -2, 2);
+            if (layout.Kind == Kind.Array)
+            {
+                pushDescriptor(L, null, layout.Element);
+                LuaAPI.xlua_rawseti(L, -2, 3);
+            }
+            else if (layout.Kind == Kind.Object)
+            {
+                pushFields(L, layout);
+                LuaAPI.xlua_rawseti(L, -2, 3);
+            }
+        }
+
+        // one field list per type, referenced by every descriptor of that type, so recursive types make a cyclic schema
+        void pushFields(RealStatePtr L, Layout layout)
+        {
+            int reference;
+            if (fieldsRefs.TryGetValue(layout.Type, out reference))
+            {
+                LuaAPI.lua_getref(L, reference);
+                return;
+            }
+            LuaAPI.lua_createtable(L, layout.Fields.Length, 0);
+            LuaAPI.lua_pushvalue(L, -1);
+            fieldsRefs.Add(layout.Type, LuaAPI.luaL_ref(L));
+            for (int i = 0; i < layout.Fields.Length; i++)
+            {
+                pushDescriptor(L, layout.Fields[i].Name, layout.FieldLayouts[i]);
+                LuaAPI.xlua_rawseti(L, -2, i + 1);
+            }
+        }
+
+        // copies the buffer xlua_snapshot left on the top of the stack, the decoding then runs without the env
+        internal static byte[] CopyBuffer(RealStatePtr L)
+        {
+            int len = LuaAPI.xlua_tointeger(L, -1);
+            var buffer = new byte[len];
+            Marshal.Copy(LuaAPI.lua_touserdata(L, -2), buffer, 0, len);
+            return buffer;
+        }
+
+        internal static T Decode<T>(byte[] buffer)
+        {
+            int pos = 0;
+            object value;
+            if (!read(buffer, ref pos, getLayout(typeof(T)), out value))
+            {
+                return default(T);
+            }
+            return (T)value;
+        }
+
+        static bool read(byte[] buffer, ref int pos, Layout layout, out object value)
+        {
+            if (buffer[pos++] == 0)
+            {
+                value = null;
+                return false;
+            }
+            switch (layout.Kind)
+            {
+                case Kind.Boolean:
+                    value = buffer[pos++] != 0;
+                    break;
+                case Kind.Integer:
+                    value = toInteger(layout, BitConverter.ToInt64(buffer, pos));
+                    pos += 8;
+                    break;
+                case Kind.Number:
+                    double d = BitConverter.ToDouble(buffer, pos);
+                    value = layout.TypeCode == TypeCode.Single ? (object)(float)d : d;
+                    pos += 8;
+                    break;
+                case Kind.String:
+                    int len = BitConverter.ToInt32(buffer, pos);
+                    value = Encoding.UTF8.GetString(buffer, pos + 4, len);
+                    pos += 4 + len;
+                    break;
+                case Kind.Object:
+                    value = Activator.CreateInstance(layout.Type);
+                    for (int i = 0; i < layout.Fields.Length; i++)
+                    {
+                        object fieldValue;
+                        if (read(buffer, ref pos, layout.FieldLayouts[i], out fieldValue))
+                        {
+                            layout.Fields[i].SetValue(value, fieldValue);
+                        }
+                    }
+                    break;
+                case Kind.Array:
+                    int n = BitConverter.ToInt32(buffer, pos);
+                    pos += 4;
+                    var elementType = layout.Element.Type;
+                    IList list;
+                    if (layout.IsList)
+                    {
+                        list = (IList)Activator.CreateInstance(layout.Type, n);
+                    }
+                    else
+                    {
+                        list = Array.CreateInstance(elementType, n);
+                    }
+                    object defaultElement = elementType.IsValueType() ? Activator.CreateInstance(elementType) : null;
+                    for (int i = 0; i < n; i++)
+                    {
+                        object element;
+                        if (!read(buffer, ref pos, layout.Element, out element))
+                        {
+                            element = defaultElement;
+                        }
+                        if (layout.IsList)
+                        {
+                            list.Add(element);
+                        }
+                        else
+                        {
+                            list[i] = element;
+                        }
+                    }
+                    value = list;
+                    break;
+                default:
+                    throw new LuaException("invalid snapshot layout");
+            }
+            return true;
+        }
+
+        static object toInteger(Layout layout, long n)
+        {
+            object value;
+            switch (layout.TypeCode)
+            {
+                case TypeCode.Char: value = (char)n; break;
+                case TypeCode.SByte: value = (sbyte)n; break;
+                case TypeCode.Byte: value = (byte)n; break;
+                case TypeCode.Int16: value = (short)n; break;
+                case TypeCode.UInt16: value = (ushort)n; break;
+                case TypeCode.Int32: value = (int)n; break;
+                case TypeCode.UInt32: value = (uint)n; break;
+                case TypeCode.UInt64: value = (ulong)n; break;
+                default: value = n; break;
+            }
+            return layout.Type.IsEnum() ? Enum.ToObject(layout.Type, value) : value;
+        }
+    }
+}
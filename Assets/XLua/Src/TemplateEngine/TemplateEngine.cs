@@ -22,6 +22,7 @@ using System.Text.RegularExpressions;
 using System.Collections.Generic;
 using System.Collections;
 using System.Text;
+using System.IO;
 using XLua;
 
 namespace XLua.TemplateEngine
@@ -175,9 +176,82 @@ namespace XLua.TemplateEngine
             return code.ToString();
         }
 
+        static Dictionary<string, string> composedCodeCache = new Dictionary<string, string>();
+
+        // parsing dominates template compiling, so the composed lua code is shared by all envs and all uses of a template.
+        // the cache is never trimmed, it is meant for the fixed set of templates of the code generator, template.compile
+        // in lua composes without it since scripts may compile any number of distinct strings
+        public static string GetComposedCode(string snippet)
+        {
+            string code;
+            lock (composedCodeCache)
+            {
+                if (composedCodeCache.TryGetValue(snippet, out code))
+                {
+                    return code;
+                }
+            }
+            code = ComposeCode(Parser.Parse(snippet));
+            lock (composedCodeCache)
+            {
+                composedCodeCache[snippet] = code;
+            }
+            return code;
+        }
+
+        //directory to keep compiled templates as lua bytecode between runs, null to disable
+        public static string BytecodeCachePath = null;
+
+        // bytecode only loads in the vm which dumped it, so the vm and the pointer size are part of the key
+        static string bytecodeCacheFile(LuaEnv luaenv, string snippet)
+        {
+            string vm = luaenv.DoString("return _VERSION .. ' ' .. (jit and jit.version or '') .. ' ' .. #string.dump(function() end)",
+                "luatemplate_vm")[0] as string;
+            using (var hasher = System.Security.Cryptography.MD5.Create())
+            {
+                return Path.Combine(BytecodeCachePath, BitConverter.ToString(hasher.ComputeHash(
+                    Encoding.UTF8.GetBytes(vm + " " + IntPtr.Size + "\n" + snippet))).Replace("-", "") + ".luac");
+            }
+        }
+
         public static LuaFunction Compile(LuaEnv luaenv, string snippet)
         {
-            return luaenv.LoadString(ComposeCode(Parser.Parse(snippet)), "luatemplate");
+            if (BytecodeCachePath == null)
+            {
+                return luaenv.LoadString(GetComposedCode(snippet), "luatemplate");
+            }
+
+            string cacheFile = bytecodeCacheFile(luaenv, snippet);
+            if (File.Exists(cacheFile))
+            {
+                try
+                {
+                    LuaFunction cached = luaenv.LoadString<LuaFunction>(File.ReadAllBytes(cacheFile), "luatemplate");
+                    if (cached != null)
+                    {
+                        return cached;
+                    }
+                }
+                catch (Exception)
+                {
+                }
+                // stale or truncated, compile it from source again and overwrite it below
+            }
+
+            LuaFunction template = luaenv.LoadString(GetComposedCode(snippet), "luatemplate");
+            try
+            {
+                LuaFunction dump = luaenv.LoadString("return string.dump(...)", "luatemplate_dump");
+                byte[] bytecode = dump.Call(new object[] { template }, new Type[] { typeof(byte[]) })[0] as byte[];
+                dump.Dispose();
+                Directory.CreateDirectory(BytecodeCachePath);
+                File.WriteAllBytes(cacheFile, bytecode);
+            }
+            catch (Exception)
+            {
+                // the cache is only an optimization
+            }
+            return template;
         }
 
         public static string Execute(LuaFunction compiledTemplate, LuaTable parameters)
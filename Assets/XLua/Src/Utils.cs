@@ -133,7 +133,33 @@ namespace XLua
 		}
 #endif
 
+		static LuaCSFunction countReflectionCall(Type type, string member, LuaCSFunction func)
+		{
+			ReflectionCallStat stat = ReflectionStats.GetStat(type, member);
+			return (RealStatePtr L) =>
+			{
+				if (!ReflectionStats.Enabled)
+				{
+					return func(L);
+				}
+				long start = System.Diagnostics.Stopwatch.GetTimestamp();
+				int ret = func(L);
+				stat.Record(start);
+				return ret;
+			};
+		}
+
 		static LuaCSFunction genFieldGetter(Type type, FieldInfo field)
+		{
+			return countReflectionCall(type, field.Name, genRawFieldGetter(type, field));
+		}
+
+		static LuaCSFunction genFieldSetter(Type type, FieldInfo field)
+		{
+			return countReflectionCall(type, field.Name, genRawFieldSetter(type, field));
+		}
+
+		static LuaCSFunction genRawFieldGetter(Type type, FieldInfo field)
 		{
 			if (field.IsStatic)
 			{
@@ -161,7 +187,7 @@ namespace XLua
 			}
 		}
 
-		static LuaCSFunction genFieldSetter(Type type, FieldInfo field)
+		static LuaCSFunction genRawFieldSetter(Type type, FieldInfo field)
 		{
 			if (field.IsStatic)
 			{
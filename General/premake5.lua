@@ -172,6 +172,7 @@ files
 {
     "./Src/XLuaUnitTest.cs",
     "../Test/UnitTest/xLuaTest/**.cs",
+    "../Assets/XLua/Src/Editor/Generator.cs",
 }
 
 defines
@@ -244,6 +245,7 @@ files
     "../Test/UnitTest/xLuaTest/**.cs",
     "../Assets/XLua/Src/*.cs",
     "../Assets/XLua/Src/TemplateEngine/*.cs",
+    "../Assets/XLua/Src/Editor/Generator.cs",
     "./Gen2/*.cs",
 }
 
@@ -65,6 +65,8 @@ public class PerfMain : MonoBehaviour {
 			StartAddRemoveCB ();
 			StartCSCallLuaCB ();
 			StartConstruct ();
+			StartMultiEnv ();
+			StartTableAccess ();
 
 			sw.Close ();
 		}
@@ -324,6 +326,113 @@ public class PerfMain : MonoBehaviour {
         PerformentTest("lua construct struct : ", LOOP_TIMES, func);
 	}
 
+	// every lua->c# call looks up the ObjectTranslator of the calling state,
+	// switching between envs shows whether that lookup stays flat as envs are added
+	private void StartMultiEnv()
+	{
+        int LOOP_TIMES = 1000000;
+        int SWITCH_EVERY = 100;
+        Debug.Log ("lua call C# with multiple envs :");
+        sw.WriteLine("lua call C# with multiple envs :");
+
+        PerfTest func = luaenv.Global.Get<PerfTest> ("LuaAccessCSStaticBaseMemberFunc");
+        PerformentTest("lua call C# static member function, one env : ", LOOP_TIMES, func);
+
+        LuaEnv[] others = new LuaEnv[3];
+        PerfTest[] funcs = new PerfTest[others.Length + 1];
+        funcs[0] = func;
+        for (int i = 0; i < others.Length; i++)
+        {
+            others[i] = new LuaEnv();
+            others[i].DoString("require 'luaTest'");
+            funcs[i + 1] = others[i].Global.Get<PerfTest>("LuaAccessCSStaticBaseMemberFunc");
+        }
+
+        PerformentTest("lua call C# static member function, " + funcs.Length + " envs interleaved : ", LOOP_TIMES, loop_times =>
+        {
+            for (int i = 0; i < loop_times / SWITCH_EVERY; i++)
+            {
+                funcs[i % funcs.Length](SWITCH_EVERY);
+            }
+        });
+
+        // the delegates must be collected before their env can be disposed
+        funcs = null;
+        System.GC.Collect();
+        System.GC.WaitForPendingFinalizers();
+        for (int i = 0; i < others.Length; i++)
+        {
+            others[i].Dispose();
+        }
+	}
+
+	// LuaTable.Get/Set go raw when no metamethod can run, the table with __index/__newindex shows the protected path
+	private void StartTableAccess()
+	{
+        int LOOP_TIMES = 1000000;
+        Debug.Log ("C# access lua table :");
+        sw.WriteLine("C# access lua table :");
+
+        LuaTable plain = luaenv.DoString("return { x = 1 }")[0] as LuaTable;
+        LuaTable withMeta = luaenv.DoString("return setmetatable({ x = 1 }, { __index = function() return 0 end, __newindex = rawset })")[0] as LuaTable;
+
+        PerformentTest("C# access lua table : plain table, get : ", LOOP_TIMES, loop_times =>
+        {
+            for (int i = 0; i < loop_times; i++)
+            {
+                plain.Get<string, int>("x");
+            }
+        });
+
+        PerformentTest("C# access lua table : plain table, set : ", LOOP_TIMES, loop_times =>
+        {
+            for (int i = 0; i < loop_times; i++)
+            {
+                plain.Set("x", i);
+            }
+        });
+
+        PerformentTest("C# access lua table : table with metatable, get present key : ", LOOP_TIMES, loop_times =>
+        {
+            for (int i = 0; i < loop_times; i++)
+            {
+                withMeta.Get<string, int>("x");
+            }
+        });
+
+        PerformentTest("C# access lua table : table with metatable, get through __index : ", LOOP_TIMES, loop_times =>
+        {
+            for (int i = 0; i < loop_times; i++)
+            {
+                withMeta.Get<string, int>("y");
+            }
+        });
+
+        LuaTable config = luaenv.DoString("return { ui = { panel = { width = 1 } } }")[0] as LuaTable;
+        LuaPath width = luaenv.CompilePath("ui.panel.width");
+
+        PerformentTest("C# access lua table : GetInPath(string) : ", LOOP_TIMES, loop_times =>
+        {
+            for (int i = 0; i < loop_times; i++)
+            {
+                config.GetInPath<int>("ui.panel.width");
+            }
+        });
+
+        PerformentTest("C# access lua table : GetInPath(LuaPath) : ", LOOP_TIMES, loop_times =>
+        {
+            for (int i = 0; i < loop_times; i++)
+            {
+                config.GetInPath<int>(width);
+            }
+        });
+
+        plain.Dispose();
+        withMeta.Dispose();
+        config.Dispose();
+        width.Dispose();
+	}
+
 	private void StartAddRemoveCB()
 	{
         int LOOP_TIMES = 200000;
@@ -656,4 +656,204 @@ function CMyTestCaseCSCallLua.testLuaTableGetSetKeyValue_delegate(self)
 	local ret = self.tcForTestCSCallLuaObj:testLuaTableGetSetKeyValue_delegate()
 	print(ret.msg)
 	ASSERT_EQ(ret.result, true)
+end
+
+function CMyTestCaseCSCallLua.testGetTableToNumberArray_bulk(self)
+    self.count = 1 + self.count
+	local ret = self.tcForTestCSCallLuaObj:testGetTableToNumberArray_bulk()
+	print(ret.msg)
+	ASSERT_EQ(ret.result, true)
+end
+
+function CMyTestCaseCSCallLua.testLuaTableStructBuffer(self)
+    self.count = 1 + self.count
+	local ret = self.tcForTestCSCallLuaObj:testLuaTableStructBuffer()
+	print(ret.msg)
+	ASSERT_EQ(ret.result, true)
+end
+
+function CMyTestCaseCSCallLua.testLuaTableSetWithStringCache(self)
+    self.count = 1 + self.count
+	local ret = self.tcForTestCSCallLuaObj:testLuaTableSetWithStringCache()
+	print(ret.msg)
+	ASSERT_EQ(ret.result, true)
+end
+
+function CMyTestCaseCSCallLua.testReflectionStatsExport(self)
+    self.count = 1 + self.count
+	local ret = self.tcForTestCSCallLuaObj:testReflectionStatsExport()
+	print(ret.msg)
+	ASSERT_EQ(ret.result, true)
+end
+
+function CMyTestCaseCSCallLua.testPostFromOtherThread(self)
+    self.count = 1 + self.count
+	local ret = self.tcForTestCSCallLuaObj:testPostFromOtherThread()
+	print(ret.msg)
+	ASSERT_EQ(ret.result, true)
+end
+
+function CMyTestCaseCSCallLua.testLuaWorkerPool(self)
+    self.count = 1 + self.count
+	local ret = self.tcForTestCSCallLuaObj:testLuaWorkerPool()
+	print(ret.msg)
+	ASSERT_EQ(ret.result, true)
+end
+
+function CMyTestCaseCSCallLua.testLuaModuleImage(self)
+    self.count = 1 + self.count
+	local ret = self.tcForTestCSCallLuaObj:testLuaModuleImage()
+	print(ret.msg)
+	ASSERT_EQ(ret.result, true)
+end
+
+function CMyTestCaseCSCallLua.testLuaTableRawFastPath(self)
+    self.count = 1 + self.count
+	local ret = self.tcForTestCSCallLuaObj:testLuaTableRawFastPath()
+	print(ret.msg)
+	ASSERT_EQ(ret.result, true)
+end
+
+function CMyTestCaseCSCallLua.testLuaPath(self)
+    self.count = 1 + self.count
+	local ret = self.tcForTestCSCallLuaObj:testLuaPath()
+	print(ret.msg)
+	ASSERT_EQ(ret.result, true)
+end
+
+function CMyTestCaseCSCallLua.testLuaTableSnapshot(self)
+    self.count = 1 + self.count
+	local ret = self.tcForTestCSCallLuaObj:testLuaTableSnapshot()
+	print(ret.msg)
+	ASSERT_EQ(ret.result, true)
+end
+
+function CMyTestCaseCSCallLua.testLuaBaseCache(self)
+    self.count = 1 + self.count
+	local ret = self.tcForTestCSCallLuaObj:testLuaBaseCache()
+	print(ret.msg)
+	ASSERT_EQ(ret.result, true)
+end
+
+function CMyTestCaseCSCallLua.testLuaRefScope(self)
+    self.count = 1 + self.count
+	local ret = self.tcForTestCSCallLuaObj:testLuaRefScope()
+	print(ret.msg)
+	ASSERT_EQ(ret.result, true)
+end
+
+function CMyTestCaseCSCallLua.testLuaTablePairs(self)
+    self.count = 1 + self.count
+	local ret = self.tcForTestCSCallLuaObj:testLuaTablePairs()
+	print(ret.msg)
+	ASSERT_EQ(ret.result, true)
+end
+
+function CMyTestCaseCSCallLua.testLuaTableCopyTo(self)
+    self.count = 1 + self.count
+	local ret = self.tcForTestCSCallLuaObj:testLuaTableCopyTo()
+	print(ret.msg)
+	ASSERT_EQ(ret.result, true)
+end
+
+function CMyTestCaseCSCallLua.testLuaTableCopyToStructs(self)
+    self.count = 1 + self.count
+	local ret = self.tcForTestCSCallLuaObj:testLuaTableCopyToStructs()
+	print(ret.msg)
+	ASSERT_EQ(ret.result, true)
+end
+
+function CMyTestCaseCSCallLua.testLuaFunctionGenericCall(self)
+    self.count = 1 + self.count
+	local ret = self.tcForTestCSCallLuaObj:testLuaFunctionGenericCall()
+	print(ret.msg)
+	ASSERT_EQ(ret.result, true)
+end
+
+function CMyTestCaseCSCallLua.testDelegateBridgePool(self)
+    self.count = 1 + self.count
+	local ret = self.tcForTestCSCallLuaObj:testDelegateBridgePool()
+	print(ret.msg)
+	ASSERT_EQ(ret.result, true)
+end
+
+function CMyTestCaseCSCallLua.testReleaseLuaBaseBatch(self)
+    self.count = 1 + self.count
+	local ret = self.tcForTestCSCallLuaObj:testReleaseLuaBaseBatch()
+	print(ret.msg)
+	ASSERT_EQ(ret.result, true)
+end
+
+function CMyTestCaseCSCallLua.testInt64PushAfterRefs(self)
+    self.count = 1 + self.count
+	local ret = self.tcForTestCSCallLuaObj:testInt64PushAfterRefs()
+	print(ret.msg)
+	ASSERT_EQ(ret.result, true)
+end
+
+function CMyTestCaseCSCallLua.testPostActionThrows(self)
+    self.count = 1 + self.count
+	local ret = self.tcForTestCSCallLuaObj:testPostActionThrows()
+	print(ret.msg)
+	ASSERT_EQ(ret.result, true)
+end
+
+function CMyTestCaseCSCallLua.testReflectionStatsUntypedMethodWrap(self)
+    self.count = 1 + self.count
+	local ret = self.tcForTestCSCallLuaObj:testReflectionStatsUntypedMethodWrap()
+	print(ret.msg)
+	ASSERT_EQ(ret.result, true)
+end
+
+function CMyTestCaseCSCallLua.testDelegateBridgeRejectsValues(self)
+    self.count = 1 + self.count
+	local ret = self.tcForTestCSCallLuaObj:testDelegateBridgeRejectsValues()
+	print(ret.msg)
+	ASSERT_EQ(ret.result, true)
+end
+
+function CMyTestCaseCSCallLua.testLuaRefScopeOtherThread(self)
+    self.count = 1 + self.count
+	local ret = self.tcForTestCSCallLuaObj:testLuaRefScopeOtherThread()
+	print(ret.msg)
+	ASSERT_EQ(ret.result, true)
+end
+
+function CMyTestCaseCSCallLua.testLuaTableCopyFrom(self)
+    self.count = 1 + self.count
+	local ret = self.tcForTestCSCallLuaObj:testLuaTableCopyFrom()
+	print(ret.msg)
+	ASSERT_EQ(ret.result, true)
+end
+
+function CMyTestCaseCSCallLua.testGenMemberSignature(self)
+    self.count = 1 + self.count
+	-- the generator is only in the general build
+	if self.tcForTestCSCallLuaObj.testGenMemberSignature == nil then return end
+	local ret = self.tcForTestCSCallLuaObj:testGenMemberSignature()
+	print(ret.msg)
+	ASSERT_EQ(ret.result, true)
+end
+
+function CMyTestCaseCSCallLua.testGenManifestTemplateCommon(self)
+    self.count = 1 + self.count
+	-- the generator is only in the general build
+	if self.tcForTestCSCallLuaObj.testGenManifestTemplateCommon == nil then return end
+	local ret = self.tcForTestCSCallLuaObj:testGenManifestTemplateCommon()
+	print(ret.msg)
+	ASSERT_EQ(ret.result, true)
+end
+
+function CMyTestCaseCSCallLua.testLuaWorkerPoolSubmitWhileDisposing(self)
+    self.count = 1 + self.count
+	local ret = self.tcForTestCSCallLuaObj:testLuaWorkerPoolSubmitWhileDisposing()
+	print(ret.msg)
+	ASSERT_EQ(ret.result, true)
+end
+
+function CMyTestCaseCSCallLua.testTemplateBytecodeCacheFallback(self)
+    self.count = 1 + self.count
+	local ret = self.tcForTestCSCallLuaObj:testTemplateBytecodeCacheFallback()
+	print(ret.msg)
+	ASSERT_EQ(ret.result, true)
 end
\ No newline at end of file
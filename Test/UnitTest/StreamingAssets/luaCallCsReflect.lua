@@ -1157,4 +1157,44 @@ function CMyTestCaseLuaCallCSReflect.CaseVariableParamFuncNoParam(self)
 	ASSERT_EQ(ret, 0)
 	local ret = CS.LuaTestObjReflect.VariableParamFunc2("abc", "haha")
 	ASSERT_EQ(ret, 2)
+end
+
+function CMyTestCaseLuaCallCSReflect.CaseOverloadShapeCache(self)
+    self.count = 1 + self.count
+	local obj = CS.LuaTestObjReflect()
+	local ints = CS.System.Array.CreateInstance(typeof(CS.System.Int32), 1)
+	local strs = CS.System.Array.CreateInstance(typeof(CS.System.String), 1)
+	for i = 1, 3 do
+		ASSERT_EQ(CS.LuaTestObjReflect.OverloadShapeFunc(1), "int")
+		ASSERT_EQ(CS.LuaTestObjReflect.OverloadShapeFunc("a"), "string")
+		ASSERT_EQ(CS.LuaTestObjReflect.OverloadShapeFunc(obj), "obj")
+		ASSERT_EQ(CS.LuaTestObjReflect.OverloadShapeFunc(ints), "int[]")
+		ASSERT_EQ(CS.LuaTestObjReflect.OverloadShapeFunc(strs), "string[]")
+	end
+end
+
+function CMyTestCaseLuaCallCSReflect.CaseCompiledInvoker(self)
+    self.count = 1 + self.count
+	local s = CS.HasConstructStructReflect(0, 1, "a")
+	for i = 1, 40 do
+		local ret, b, c = CS.LuaTestObjReflect.CompiledRefFunc(i, 1)
+		ASSERT_EQ(ret, i * 2)
+		ASSERT_EQ(b, i + 1)
+		ASSERT_EQ(c, "r" .. (i + 1))
+		ASSERT_EQ(s:Move(1), i)
+		ASSERT_EQ(s.x, i)
+		ASSERT_EQ(CS.HasConstructStructReflect(i, 2, "b").x, i)
+		local ok, err = pcall(CS.LuaTestObjReflect.CompiledThrowFunc, i)
+		ASSERT_EQ(ok, i <= 20)
+		if not ok then
+			ASSERT_EQ(string.find(err, "compiled " .. i) ~= nil, true)
+		end
+	end
+end
+
+function CMyTestCaseLuaCallCSReflect.CaseCompiledInvokerDefaultStruct(self)
+    self.count = 1 + self.count
+	for i = 1, 40 do
+		ASSERT_EQ(CS.LuaTestObjReflect.CompiledDefaultFunc(i), i)
+	end
 end
\ No newline at end of file
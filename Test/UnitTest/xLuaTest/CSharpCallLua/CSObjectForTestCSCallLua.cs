@@ -197,3 +197,11 @@ public delegate string FucnReadFileDelegate(string filename);
 
 [CSharpCallLua]
 public delegate System.Object FuncReturnObjectDelegate(int type);
+
+public class ReflectionStatsTestObj
+{
+	private int Add(int a, int b)
+	{
+		return a + b;
+	}
+}
\ No newline at end of file
@@ -3074,4 +3074,1333 @@ public class TCForTestCSCallLua{
         return result;
     }
 
+    public TestResult testGetTableToNumberArray_bulk()
+    {
+        string caseName = "testGetTableToNumberArray_bulk: ";
+        LOG("*************" + caseName);
+        TestResult result;
+
+        luaEnv.DoString(@"
+            bulkNumbers = {}
+            for i = 1, 1000 do bulkNumbers[i] = i * 0.5 end
+            bulkMixed = {1, 2, '3', 4}");
+
+        float[] floats = luaEnv.Global.Get<float[]>("bulkNumbers");
+        List<double> doubles = luaEnv.Global.Get<List<double>>("bulkNumbers");
+        int[] mixed = luaEnv.Global.Get<int[]>("bulkMixed");
+        List<int> mixedList = luaEnv.Global.Get<List<int>>("bulkMixed");
+
+        if (floats.Length == 1000 && floats[999] == 500f && doubles.Count == 1000 && doubles[1] == 1.0
+            && mixed.Length == 4 && mixed[2] == 3 && mixed[3] == 4 && mixedList.Count == 3 && mixedList[2] == 4)
+        {
+            setResult(true, "pass", out result);
+        }
+        else
+        {
+            setResult(false, "bulk converted values mismatch", out result);
+        }
+
+        LOG(caseName + result.ToString());
+        return result;
+    }
+
+    public TestResult testLuaTableStructBuffer()
+    {
+        string caseName = "testLuaTableStructBuffer: ";
+        LOG("*************" + caseName);
+        TestResult result;
+
+        // runtime packers stand in for the ones generated code registers for GCOptimize structs
+        luaEnv.translator.RegisterStructPacker<float>(4, CopyByValue.Pack, CopyByValue.UnPack);
+        float[] values = new float[] { 1, 2, 3, 4, 5, 6 };
+        luaEnv.Global.SetStructBuffer("structBuffer", values);
+        luaEnv.DoString(@"
+            local get_y, set_y, count = xlua.genarrayaccessor(4, 8, 8)
+            structBufferCount = count(structBuffer)
+            structBufferY3 = get_y(structBuffer, 3)
+            set_y(structBuffer, 1, 20)
+            structBufferOutOfRange = not pcall(get_y, structBuffer, 4) and not pcall(get_y, structBuffer, 0x7fffffff)
+                and not pcall(set_y, structBuffer, 0x40000001, 1)");
+        luaEnv.Global.GetStructBuffer("structBuffer", values);
+        bool tooSmallRejected = false;
+        var larger = new float[7];
+        try
+        {
+            luaEnv.Global.GetStructBuffer("structBuffer", larger);
+        }
+        catch (Exception)
+        {
+            tooSmallRejected = larger[0] == 0;
+        }
+
+        if (luaEnv.Global.Get<int>("structBufferCount") == 3 && luaEnv.Global.Get<float>("structBufferY3") == 6 && values[1] == 20
+            && luaEnv.Global.Get<bool>("structBufferOutOfRange") && tooSmallRejected)
+        {
+            setResult(true, "pass", out result);
+        }
+        else
+        {
+            setResult(false, "struct buffer values mismatch", out result);
+        }
+
+        LOG(caseName + result.ToString());
+        return result;
+    }
+
+    public TestResult testLuaTableSetWithStringCache()
+    {
+        string caseName = "testLuaTableSetWithStringCache: ";
+        LOG("*************" + caseName);
+        TestResult result;
+
+        luaEnv.StringCacheSize = 2;
+        string first = "cached_string_1";
+        luaEnv.Global.Set("cachedStr1", first);
+        luaEnv.Global.Set("cachedStr2", first);
+        luaEnv.Global.Set("cachedStr3", "cached_string_2");
+        luaEnv.Global.Set("cachedStr4", "cached_string_3");
+        luaEnv.Global.Set("cachedStr5", first);
+        luaEnv.Global.Set<string, string>("cachedStr6", null);
+        luaEnv.StringCacheSize = 0;
+
+        if (luaEnv.Global.Get<string>("cachedStr2") == first && luaEnv.Global.Get<string>("cachedStr4") == "cached_string_3"
+            && luaEnv.Global.Get<string>("cachedStr5") == first && !luaEnv.Global.ContainsKey("cachedStr6"))
+        {
+            setResult(true, "pass", out result);
+        }
+        else
+        {
+            setResult(false, "cached strings mismatch", out result);
+        }
+
+        LOG(caseName + result.ToString());
+        return result;
+    }
+
+    public TestResult testReflectionStatsExport()
+    {
+        string caseName = "testReflectionStatsExport: ";
+        LOG("*************" + caseName);
+        TestResult result;
+
+        ReflectionStats.Reset();
+        ReflectionStats.Enabled = true;
+        luaEnv.DoString(@"
+            xlua.private_accessible(CS.ReflectionStatsTestObj)
+            local obj = CS.ReflectionStatsTestObj()
+            for i = 1, 5 do obj:Add(i, 1) end
+        ");
+        ReflectionStats.Enabled = false;
+
+        var stat = ReflectionStats.GetStats().Find(s => s.Type == typeof(ReflectionStatsTestObj) && s.Member == "Add");
+        string config = ReflectionStats.ExportGenConfig(10);
+        if (stat != null && stat.Calls == 5 && config.Contains("typeof(ReflectionStatsTestObj)") && config.Contains("[LuaCallCSharp]"))
+        {
+            setResult(true, "pass", out result);
+        }
+        else
+        {
+            setResult(false, "unexpected stats: " + config, out result);
+        }
+
+        LOG(caseName + result.ToString());
+        return result;
+    }
+
+    public TestResult testPostFromOtherThread()
+    {
+        string caseName = "testPostFromOtherThread: ";
+        LOG("*************" + caseName);
+        TestResult result;
+
+        luaEnv.Global.Set("postedValue", 0);
+        var thread = new System.Threading.Thread(() =>
+        {
+            luaEnv.Post(() => luaEnv.DoString("postedValue = postedValue + 1"));
+            luaEnv.Post(() => luaEnv.DoString("postedValue = postedValue * 10"));
+        });
+        thread.Start();
+        thread.Join();
+
+        int beforeTick = luaEnv.Global.Get<int>("postedValue");
+        luaEnv.Tick();
+        int afterTick = luaEnv.Global.Get<int>("postedValue");
+        if (beforeTick == 0 && afterTick == 10)
+        {
+            setResult(true, "pass", out result);
+        }
+        else
+        {
+            setResult(false, "posted actions ran out of order or outside Tick: " + beforeTick + ", " + afterTick, out result);
+        }
+
+        LOG(caseName + result.ToString());
+        return result;
+    }
+
+    public TestResult testLuaWorkerPool()
+    {
+        string caseName = "testLuaWorkerPool: ";
+        LOG("*************" + caseName);
+        TestResult result;
+
+        using (var pool = new LuaWorkerPool(2, env => env.DoString(@"
+            function sum(t, scale)
+                local s = 0
+                for _, v in ipairs(t) do s = s + v end
+                return s * scale, { count = #t, name = t.name }
+            end
+            function square(x) return x * x end
+            function sum_squares(n)
+                local pool, env = CS.XLua.LuaWorkerPool.Current, CS.XLua.LuaWorkerPool.CurrentEnv
+                local jobs = {}
+                for i = 1, n do jobs[i] = pool:Submit('square', i) end
+                local s = 0
+                for i = 1, n do s = s + jobs[i]:GetResults(env)[0] end
+                return s
+            end
+            function fail() error('worker failure') end
+        ")))
+        {
+            var input = luaEnv.DoString("return { 1, 2, 3, name = 'numbers' }")[0] as LuaTable;
+            var sumJob = pool.Submit("sum", input, 2);
+            var nestedJob = pool.Submit("sum_squares", 10);
+            var failJob = pool.Submit("fail");
+
+            var sumResults = sumJob.GetResults(luaEnv);
+            var info = sumResults[1] as LuaTable;
+            long nested = Convert.ToInt64(nestedJob.GetResults(luaEnv)[0]);
+            bool failed = false;
+            try
+            {
+                failJob.GetResults(luaEnv);
+            }
+            catch (LuaException e)
+            {
+                failed = e.Message.Contains("worker failure");
+            }
+
+            if (Convert.ToInt64(sumResults[0]) == 12 && info != null && info.Get<int>("count") == 3 && info.Get<string>("name") == "numbers"
+                && nested == 385 && failed)
+            {
+                setResult(true, "pass", out result);
+            }
+            else
+            {
+                setResult(false, "unexpected worker results", out result);
+            }
+            input.Dispose();
+            info.Dispose();
+        }
+
+        LOG(caseName + result.ToString());
+        return result;
+    }
+
+    public TestResult testLuaModuleImage()
+    {
+        string caseName = "testLuaModuleImage: ";
+        LOG("*************" + caseName);
+        TestResult result;
+
+        luaEnv.AddLoader((ref string path) => path == "module_image_test"
+            ? System.Text.Encoding.UTF8.GetBytes("local M = {}\nfunction M.add(a, b) return a + b end\nfunction M.where() return debug.getinfo(1, 'S').source end\nreturn M")
+            : null);
+        var image = LuaModuleImage.Build(luaEnv, new string[] { "module_image_test", "string" });
+
+        var other = new LuaEnv();
+        other.AddModuleImage(image);
+        var ret = other.DoString("local m = require 'module_image_test' return m.add(1, 2), m.where()");
+        long sum = Convert.ToInt64(ret[0]);
+        string source = ret[1] as string;
+        other.Dispose();
+
+        if (image.Count == 1 && sum == 3 && source == "@module_image_test")
+        {
+            setResult(true, "pass", out result);
+        }
+        else
+        {
+            setResult(false, "unexpected image result: " + image.Count + ", " + sum + ", " + source, out result);
+        }
+
+        LOG(caseName + result.ToString());
+        return result;
+    }
+
+    public TestResult testLuaTableRawFastPath()
+    {
+        string caseName = "testLuaTableRawFastPath: ";
+        LOG("*************" + caseName);
+        TestResult result;
+
+        LuaTable table = luaEnv.DoString(@"
+            newindex_log = {}
+            return setmetatable({ present = 1 }, {
+                __index = function(t, k) return 'default_' .. k end,
+                __newindex = function(t, k, v) table.insert(newindex_log, k) rawset(t, k, v) end,
+            })
+        ")[0] as LuaTable;
+        LuaTable plain = luaEnv.NewTable();
+
+        plain.Set("a", 1);
+        table.Set("present", 2);
+        table.Set("absent", 3);
+        table.Set("absent", 4);
+        bool nanRejected = false;
+        try
+        {
+            plain.Set(double.NaN, 1);
+        }
+        catch (LuaException)
+        {
+            nanRejected = true;
+        }
+
+        string log = luaEnv.DoString("return table.concat(newindex_log, ',')")[0] as string;
+        if (plain.Get<int>("a") == 1 && plain.Get<object>("b") == null && table.Get<int>("present") == 2
+            && table.Get<int>("absent") == 4 && table.Get<string>("missing") == "default_missing" && log == "absent" && nanRejected)
+        {
+            setResult(true, "pass", out result);
+        }
+        else
+        {
+            setResult(false, "unexpected table access result, newindex log: " + log, out result);
+        }
+        table.Dispose();
+        plain.Dispose();
+
+        LOG(caseName + result.ToString());
+        return result;
+    }
+
+    public TestResult testLuaPath()
+    {
+        string caseName = "testLuaPath: ";
+        LOG("*************" + caseName);
+        TestResult result;
+
+        LuaTable table = luaEnv.DoString(@"
+            return {
+                a = { b = { c = 1 } },
+                lazy = setmetatable({}, { __index = function(t, k) return { c = 'lazy_' .. k } end }),
+                leaf = 5,
+            }
+        ")[0] as LuaTable;
+        LuaPath abc = luaEnv.CompilePath("a.b.c");
+        LuaPath lazy = luaEnv.CompilePath("lazy.x.c");
+        LuaPath missing = luaEnv.CompilePath("a.none.c");
+        LuaPath throughLeaf = luaEnv.CompilePath("leaf.c");
+        LuaPath newKey = luaEnv.CompilePath("a.b.d");
+
+        abc.Set(table, 2);
+        table.SetInPath(newKey, "d");
+        bool setThroughLeafFailed = false;
+        try
+        {
+            throughLeaf.Set(table, 1);
+        }
+        catch (LuaException)
+        {
+            setThroughLeafFailed = true;
+        }
+
+        if (abc.Get<int>(table) == 2 && table.GetInPath<int>("a.b.c") == 2 && table.GetInPath<string>(newKey) == "d"
+            && lazy.Get<string>(table) == "lazy_x" && missing.Get<object>(table) == null
+            && throughLeaf.Get<object>(table) == null && setThroughLeafFailed)
+        {
+            setResult(true, "pass", out result);
+        }
+        else
+        {
+            setResult(false, "unexpected path access result", out result);
+        }
+        abc.Dispose();
+        lazy.Dispose();
+        missing.Dispose();
+        throughLeaf.Dispose();
+        newKey.Dispose();
+        table.Dispose();
+
+        LOG(caseName + result.ToString());
+        return result;
+    }
+
+    public enum SnapshotKind { None, Melee, Ranged }
+
+    public struct SnapshotPoint
+    {
+        public float x;
+        public float y;
+    }
+
+    public class SnapshotItem
+    {
+        public int id;
+        public string name = "unnamed";
+        public SnapshotKind kind;
+        public bool stackable;
+        public long price;
+        public double weight;
+        public SnapshotPoint[] path;
+        public List<string> tags;
+        public SnapshotItem child;
+    }
+
+    public TestResult testLuaTableSnapshot()
+    {
+        string caseName = "testLuaTableSnapshot: ";
+        LOG("*************" + caseName);
+        TestResult result;
+
+        LuaTable table = luaEnv.DoString(@"
+            return {
+                id = 7, name = 'sword', kind = 2, stackable = true, price = 12345678901, weight = 2.5,
+                path = { { x = 1, y = 2 }, { x = 3.5 } },
+                tags = { 'a', 'b' },
+                child = { id = 8 },
+            }
+        ")[0] as LuaTable;
+        LuaTable items = luaEnv.DoString("return { { id = 1 }, { id = 2, name = 'two' } }")[0] as LuaTable;
+        LuaTable broken = luaEnv.DoString("return { id = 'not a number' }")[0] as LuaTable;
+
+        var item = table.Snapshot<SnapshotItem>();
+        var list = items.Snapshot<SnapshotItem[]>();
+        bool brokenRejected = false;
+        try
+        {
+            broken.Snapshot<SnapshotItem>();
+        }
+        catch (LuaException)
+        {
+            brokenRejected = true;
+        }
+
+        if (item.id == 7 && item.name == "sword" && item.kind == SnapshotKind.Ranged && item.stackable && item.price == 12345678901L
+            && item.weight == 2.5 && item.path.Length == 2 && item.path[0].y == 2 && item.path[1].x == 3.5f && item.path[1].y == 0
+            && item.tags.Count == 2 && item.tags[1] == "b" && item.child.id == 8 && item.child.name == "unnamed" && item.child.path == null
+            && list.Length == 2 && list[0].id == 1 && list[1].name == "two" && brokenRejected)
+        {
+            setResult(true, "pass", out result);
+        }
+        else
+        {
+            setResult(false, "unexpected snapshot", out result);
+        }
+        table.Dispose();
+        items.Dispose();
+        broken.Dispose();
+
+        LOG(caseName + result.ToString());
+        return result;
+    }
+
+    public TestResult testLuaBaseCache()
+    {
+        string caseName = "testLuaBaseCache: ";
+        LOG("*************" + caseName);
+        TestResult result;
+
+        luaEnv.DoString("cache_test = { callbacks = { value = 1 }, on_event = function() return 2 end }");
+        LuaTable holder = luaEnv.Global.Get<LuaTable>("cache_test");
+        luaEnv.LuaBaseCacheEnabled = true;
+
+        LuaTable first = holder.Get<LuaTable>("callbacks");
+        LuaTable second = holder.Get<LuaTable>("callbacks");
+        LuaFunction f1 = holder.Get<LuaFunction>("on_event");
+        LuaFunction f2 = holder.Get<LuaFunction>("on_event");
+        bool same = ReferenceEquals(first, second) && ReferenceEquals(f1, f2) && (int)(long)f1.Call()[0] == 2;
+
+        first.Dispose();
+        LuaTable third = holder.Get<LuaTable>("callbacks");
+        bool fresh = !ReferenceEquals(first, third) && third.Get<int>("value") == 1
+            && ReferenceEquals(third, holder.Get<LuaTable>("callbacks"));
+
+        luaEnv.LuaBaseCacheEnabled = false;
+        LuaTable uncached = holder.Get<LuaTable>("callbacks");
+        bool off = !ReferenceEquals(uncached, third) && uncached.Get<int>("value") == 1;
+
+        if (same && fresh && off)
+        {
+            setResult(true, "pass", out result);
+        }
+        else
+        {
+            setResult(false, "same: " + same + ", fresh: " + fresh + ", off: " + off, out result);
+        }
+        third.Dispose();
+        uncached.Dispose();
+        f1.Dispose();
+        holder.Dispose();
+        luaEnv.DoString("cache_test = nil");
+
+        LOG(caseName + result.ToString());
+        return result;
+    }
+
+    public TestResult testLuaRefScope()
+    {
+        string caseName = "testLuaRefScope: ";
+        LOG("*************" + caseName);
+        TestResult result;
+
+        luaEnv.DoString("scope_weak = setmetatable({}, { __mode = 'v' })");
+        LuaTable kept;
+        bool wrongOrderRejected = false;
+        using (var scope = luaEnv.BeginRefScope())
+        {
+            luaEnv.DoString("local t = {} scope_weak[1] = t return t");
+            kept = scope.Keep(luaEnv.DoString("local t = {} scope_weak[2] = t return t")[0] as LuaTable);
+            var inner = luaEnv.BeginRefScope();
+            luaEnv.DoString("local t = {} scope_weak[3] = t return t");
+            try
+            {
+                scope.Dispose();
+            }
+            catch (InvalidOperationException)
+            {
+                wrongOrderRejected = true;
+            }
+            inner.Dispose();
+            inner.Dispose();
+        }
+        luaEnv.FullGc();
+        bool released = (bool)luaEnv.DoString("return scope_weak[1] == nil and scope_weak[3] == nil and scope_weak[2] ~= nil")[0];
+        kept.Dispose();
+        luaEnv.FullGc();
+        bool keptReleased = (bool)luaEnv.DoString("return scope_weak[2] == nil")[0];
+
+        if (released && keptReleased && wrongOrderRejected)
+        {
+            setResult(true, "pass", out result);
+        }
+        else
+        {
+            setResult(false, "released: " + released + ", kept released: " + keptReleased + ", wrong order rejected: " + wrongOrderRejected, out result);
+        }
+        luaEnv.DoString("scope_weak = nil");
+
+        LOG(caseName + result.ToString());
+        return result;
+    }
+
+    public TestResult testLuaTablePairs()
+    {
+        string caseName = "testLuaTablePairs: ";
+        LOG("*************" + caseName);
+        TestResult result;
+
+        LuaTable table = luaEnv.DoString("return { a = 1, b = 2, c = 3, 10, 20 }")[0] as LuaTable;
+        LuaTable inner = luaEnv.DoString("return { x = 100 }")[0] as LuaTable;
+
+        int sum = 0, count = 0, nested = 0;
+        foreach (var kv in table.Pairs<string, int>())
+        {
+            sum += kv.Value;
+            count++;
+            foreach (var innerKv in inner.Pairs<string, int>())
+            {
+                nested += innerKv.Value;
+            }
+        }
+
+        int indexSum = 0;
+        foreach (var kv in table.Pairs<int, int>())
+        {
+            indexSum += kv.Key * kv.Value;
+        }
+
+        // an early break restores the stack, so repeating it many times does not grow it
+        for (int i = 0; i < 100000; i++)
+        {
+            foreach (var kv in table.Pairs<string, int>())
+            {
+                break;
+            }
+        }
+
+        if (sum == 6 && count == 3 && nested == 300 && indexSum == 50 && table.Get<int>("a") == 1)
+        {
+            setResult(true, "pass", out result);
+        }
+        else
+        {
+            setResult(false, "sum: " + sum + ", count: " + count + ", nested: " + nested + ", indexSum: " + indexSum, out result);
+        }
+        table.Dispose();
+        inner.Dispose();
+
+        LOG(caseName + result.ToString());
+        return result;
+    }
+
+    public TestResult testLuaTableCopyTo()
+    {
+        string caseName = "testLuaTableCopyTo: ";
+        LOG("*************" + caseName);
+        TestResult result;
+
+        LuaTable numbers = luaEnv.DoString("return { 1, 2.5, 3, 4, 5 }")[0] as LuaTable;
+        LuaTable longs = luaEnv.DoString("return { 1, 12345678901, -2 }")[0] as LuaTable;
+        LuaTable names = luaEnv.DoString("return { 'a', 'b' }")[0] as LuaTable;
+
+        var doubles = new double[8];
+        int doubleCount = numbers.CopyTo(doubles);
+        var ints = new int[3];
+        int intCount = numbers.CopyTo(ints);
+        var longValues = new long[3];
+        longs.CopyTo(longValues);
+        var strings = new string[2];
+        names.CopyTo(strings);
+        var fromList = longs.Cast<List<long>>();
+
+        if (doubleCount == 5 && doubles[1] == 2.5 && doubles[4] == 5 && doubles[5] == 0 && intCount == 3 && ints[2] == 3
+            && longValues[1] == 12345678901L && longValues[2] == -2 && strings[1] == "b" && fromList[1] == 12345678901L)
+        {
+            setResult(true, "pass", out result);
+        }
+        else
+        {
+            setResult(false, "unexpected copy result", out result);
+        }
+        numbers.Dispose();
+        longs.Dispose();
+        names.Dispose();
+
+        LOG(caseName + result.ToString());
+        return result;
+    }
+
+    public struct CopyPoint
+    {
+        public float x;
+        public float y;
+    }
+
+    public TestResult testLuaTableCopyToStructs()
+    {
+        string caseName = "testLuaTableCopyToStructs: ";
+        LOG("*************" + caseName);
+        TestResult result;
+
+        // a runtime packer stands in for the one generated code registers for a GCOptimize struct
+        luaEnv.translator.RegisterStructPacker<CopyPoint>(8, (IntPtr buff, int offset, CopyPoint p) =>
+        {
+            return CopyByValue.Pack(buff, offset, p.x) && CopyByValue.Pack(buff, offset + 4, p.y);
+        }, (IntPtr buff, int offset, out CopyPoint p) =>
+        {
+            p = new CopyPoint();
+            return CopyByValue.UnPack(buff, offset, out p.x) && CopyByValue.UnPack(buff, offset + 4, out p.y);
+        });
+
+        var L = luaEnv.L;
+        int oldTop = XLua.LuaDLL.Lua.lua_gettop(L);
+        bool isFirst;
+        int typeId = luaEnv.translator.getTypeId(L, typeof(CopyPoint), out isFirst);
+        XLua.LuaDLL.Lua.lua_newtable(L);
+        for (int i = 0; i < 3; i++)
+        {
+            IntPtr buff = XLua.LuaDLL.Lua.xlua_pushstruct(L, 8, typeId);
+            CopyByValue.Pack(buff, 0, (float)i);
+            CopyByValue.Pack(buff, 4, (float)(i * 10));
+            XLua.LuaDLL.Lua.xlua_rawseti(L, -2, i + 1);
+        }
+        // a boxed object of the struct type shares its metatable but is only an index userdata
+        luaEnv.translator.PushObject(L, new CopyPoint() { x = 2, y = 20 }, typeId);
+        XLua.LuaDLL.Lua.xlua_rawseti(L, -2, 3);
+        LuaTable points = luaEnv.translator.GetObject(L, -1, typeof(LuaTable)) as LuaTable;
+        XLua.LuaDLL.Lua.lua_settop(L, oldTop);
+        luaEnv.Global.Set("copy_points", points);
+        luaEnv.DoString("copy_points[4] = { x = 3, y = 30 }");
+
+        var dest = new CopyPoint[4];
+        int count = points.CopyTo(dest);
+
+        if (count == 4 && dest[0].y == 0 && dest[2].x == 2 && dest[2].y == 20 && dest[3].x == 3 && dest[3].y == 30)
+        {
+            setResult(true, "pass", out result);
+        }
+        else
+        {
+            setResult(false, "unexpected struct copy result", out result);
+        }
+        points.Dispose();
+        luaEnv.DoString("copy_points = nil");
+
+        LOG(caseName + result.ToString());
+        return result;
+    }
+
+    public TestResult testLuaFunctionGenericCall()
+    {
+        string caseName = "testLuaFunctionGenericCall: ";
+        LOG("*************" + caseName);
+        TestResult result;
+
+        LuaFunction sum = luaEnv.DoString("return function(...) local s = 0 for _, v in ipairs({...}) do s = s + v end return s end")[0] as LuaFunction;
+        LuaFunction split = luaEnv.DoString("return function(a, b, c) return a + b + c, 'n' .. c, a > 0, b * 2 end")[0] as LuaFunction;
+        LuaFunction many = luaEnv.DoString("return function(n) local r = {} for i = 1, n do r[i] = i * 10 end return (table.unpack or unpack)(r) end")[0] as LuaFunction;
+        LuaFunction fail = luaEnv.DoString("return function() error('generic call failed') end")[0] as LuaFunction;
+
+        int oldTop = XLua.LuaDLL.Lua.lua_gettop(luaEnv.L);
+        int total = sum.Func<int, int, int, int, int, int, int, int, int>(1, 2, 3, 4, 5, 6, 7, 8);
+        sum.Action(1, 2, 3, 4, 5, 6, 7, 8);
+        double first;
+        string second;
+        bool third;
+        long fourth;
+        split.Call(1, 2L, 3.5, out first, out second, out third, out fourth);
+        var buffer = new int[3];
+        int written = many.CallInto(5, buffer);
+        int none = many.CallInto(0, buffer);
+        // a missing results array is rejected before the function runs
+        LuaFunction counted = luaEnv.DoString("generic_call_count = 0 return function(n) generic_call_count = generic_call_count + 1 return n end")[0] as LuaFunction;
+        bool nullRejected = false;
+        try
+        {
+            counted.CallInto(1, (int[])null);
+        }
+        catch (ArgumentNullException)
+        {
+            nullRejected = luaEnv.Global.Get<int>("generic_call_count") == 0;
+        }
+        counted.Dispose();
+        bool thrown = false;
+        try
+        {
+            fail.Action();
+        }
+        catch (LuaException e)
+        {
+            thrown = e.Message.Contains("generic call failed");
+        }
+        int newTop = XLua.LuaDLL.Lua.lua_gettop(luaEnv.L);
+
+        if (total == 36 && first == 6.5 && second == "n3.5" && third && fourth == 4 && written == 3 && buffer[0] == 10
+            && buffer[2] == 30 && none == 0 && nullRejected && thrown && oldTop == newTop)
+        {
+            setResult(true, "pass", out result);
+        }
+        else
+        {
+            setResult(false, "unexpected call result", out result);
+        }
+        sum.Dispose();
+        split.Dispose();
+        many.Dispose();
+        fail.Dispose();
+
+        LOG(caseName + result.ToString());
+        return result;
+    }
+
+    [System.Runtime.CompilerServices.MethodImpl(System.Runtime.CompilerServices.MethodImplOptions.NoInlining)]
+    static int bindAndDrop(LuaTable env, string name)
+    {
+        var callback = env.Get<Action>(name);
+        callback();
+        return callback.GetHashCode();
+    }
+
+    [System.Runtime.CompilerServices.MethodImpl(System.Runtime.CompilerServices.MethodImplOptions.NoInlining)]
+    static bool bindTwice(LuaTable env, string name)
+    {
+        var first = env.Get<Action>(name);
+        var second = env.Get<Action>(name);
+        return first == second;
+    }
+
+    public TestResult testDelegateBridgePool()
+    {
+        string caseName = "testDelegateBridgePool: ";
+        LOG("*************" + caseName);
+        TestResult result;
+
+        luaEnv.DoString("delegate_pool_count = 0 function delegate_pool_cb() delegate_pool_count = delegate_pool_count + 1 end");
+        luaEnv.ResetDelegateBridgeStats();
+
+        bool same = bindTwice(luaEnv.Global, "delegate_pool_cb");
+        var shared = luaEnv.GetDelegateBridgeStats();
+        GC.Collect();
+        GC.WaitForPendingFinalizers();
+        luaEnv.Tick();
+
+        luaEnv.DelegateBridgePoolSize = 4;
+        bindAndDrop(luaEnv.Global, "delegate_pool_cb");
+        GC.Collect();
+        GC.WaitForPendingFinalizers();
+        luaEnv.Tick();
+        luaEnv.ResetDelegateBridgeStats();
+        bindAndDrop(luaEnv.Global, "delegate_pool_cb");
+        GC.Collect();
+        GC.WaitForPendingFinalizers();
+        luaEnv.Tick();
+        var pooled = luaEnv.GetDelegateBridgeStats();
+
+        luaEnv.DelegateBridgePoolSize = 0;
+        GC.Collect();
+        GC.WaitForPendingFinalizers();
+        luaEnv.Tick();
+        var released = luaEnv.GetDelegateBridgeStats();
+        int count = luaEnv.Global.Get<int>("delegate_pool_count");
+
+        if (same && shared.Created == 1 && shared.Reused == 1 && shared.DelegatesCreated == 1 && pooled.Created == 0
+            && pooled.Reused == 1 && released.Released == 1 && count == 2)
+        {
+            setResult(true, "pass", out result);
+        }
+        else
+        {
+            setResult(false, "unexpected bridge stats", out result);
+        }
+
+        LOG(caseName + result.ToString());
+        return result;
+    }
+
+    public TestResult testReleaseLuaBaseBatch()
+    {
+        string caseName = "testReleaseLuaBaseBatch: ";
+        LOG("*************" + caseName);
+        TestResult result;
+
+        LuaTable weak = luaEnv.DoString(@"
+            local weak = setmetatable({}, { __mode = 'v' })
+            release_batch_strong = {}
+            for i = 1, 200 do
+                release_batch_strong[i] = i % 2 == 0 and {} or function() return i end
+                weak[i] = release_batch_strong[i]
+            end
+            return weak")[0] as LuaTable;
+        LuaFunction alive = luaEnv.DoString("return function(t) collectgarbage() collectgarbage() local n = 0 for _ in pairs(t) do n = n + 1 end return n end")[0] as LuaFunction;
+
+        luaEnv.Tick();
+        luaEnv.ResetDelegateBridgeStats();
+        // disposing queues the same GC actions the finalizers would, without depending on when the runtime collects
+        var wrappers = new List<LuaBase>();
+        for (int i = 1; i <= 200; i++)
+        {
+            if (i % 2 == 0)
+            {
+                wrappers.Add(weak.Get<int, LuaTable>(i));
+            }
+            else
+            {
+                wrappers.Add(weak.Get<int, Action>(i).Target as LuaBase);
+            }
+        }
+        luaEnv.DoString("release_batch_strong = nil");
+        int held = alive.Func<LuaTable, int>(weak);
+        foreach (var wrapper in wrappers)
+        {
+            wrapper.Dispose();
+        }
+        luaEnv.Tick();
+        int left = alive.Func<LuaTable, int>(weak);
+        var stats = luaEnv.GetDelegateBridgeStats();
+
+        if (held == 200 && left == 0 && stats.Created == 100 && stats.Released >= 100)
+        {
+            setResult(true, "pass", out result);
+        }
+        else
+        {
+            setResult(false, "held: " + held + ", left: " + left + ", created: " + stats.Created + ", released: " + stats.Released, out result);
+        }
+        weak.Dispose();
+        alive.Dispose();
+
+        LOG(caseName + result.ToString());
+        return result;
+    }
+
+    public TestResult testInt64PushAfterRefs()
+    {
+        string caseName = "testInt64PushAfterRefs: ";
+        LOG("*************" + caseName);
+        TestResult result;
+
+        var tables = new List<LuaTable>();
+        for (int i = 0; i < 16; i++)
+        {
+            tables.Add(luaEnv.NewTable());
+        }
+        LuaFunction same = luaEnv.DoString("return function(a, b) return a == b end")[0] as LuaFunction;
+        LuaFunction empty = luaEnv.DoString("return function(t) return next(t) == nil end")[0] as LuaFunction;
+        // without interning lua5.1 boxes every push in a new userdata
+        LuaFunction notInterned = luaEnv.DoString("return function(a, b) return rawequal(a, b) == (_VERSION ~= 'Lua 5.1') end")[0] as LuaFunction;
+        // == would pass through the int64 __eq metamethod, only rawequal shows the pushes share one userdata
+        LuaFunction rawSame = luaEnv.DoString("return function(a, b) return rawequal(a, b) end")[0] as LuaFunction;
+
+        bool equal = same.Func<long, long, bool>(12345678901L, 12345678901L) && notInterned.Func<long, long, bool>(5L, 5L);
+        luaEnv.DoString("uint64.intern(false) uint64.intern(true)");
+        bool internedEqual = rawSame.Func<long, long, bool>(-7L, -7L);
+        luaEnv.DoString("uint64.intern(false)");
+        bool untouched = true;
+        foreach (var table in tables)
+        {
+            untouched = untouched && empty.Func<LuaTable, bool>(table);
+            table.Dispose();
+        }
+
+        if (equal && internedEqual && untouched)
+        {
+            setResult(true, "pass", out result);
+        }
+        else
+        {
+            setResult(false, "int64 push touched a referenced table", out result);
+        }
+        same.Dispose();
+        empty.Dispose();
+        notInterned.Dispose();
+        rawSame.Dispose();
+
+        LOG(caseName + result.ToString());
+        return result;
+    }
+
+    public TestResult testPostActionThrows()
+    {
+        string caseName = "testPostActionThrows: ";
+        LOG("*************" + caseName);
+        TestResult result;
+
+        luaEnv.DoString("post_throw_value = 0 function post_throw_cb() end");
+        GC.Collect();
+        GC.WaitForPendingFinalizers();
+        luaEnv.Tick();
+        luaEnv.ResetDelegateBridgeStats();
+        bindAndDrop(luaEnv.Global, "post_throw_cb");
+        GC.Collect();
+        GC.WaitForPendingFinalizers();
+
+        luaEnv.Post(() => { throw new InvalidOperationException("posted failure"); });
+        luaEnv.Post(() => luaEnv.DoString("post_throw_value = 1"));
+        bool thrown = false;
+        try
+        {
+            luaEnv.Tick();
+        }
+        catch (InvalidOperationException e)
+        {
+            thrown = e.Message == "posted failure";
+        }
+        int value = luaEnv.Global.Get<int>("post_throw_value");
+        var stats = luaEnv.GetDelegateBridgeStats();
+
+        if (thrown && value == 1 && stats.Released >= 1)
+        {
+            setResult(true, "pass", out result);
+        }
+        else
+        {
+            setResult(false, "a failing posted action stopped Tick", out result);
+        }
+
+        LOG(caseName + result.ToString());
+        return result;
+    }
+
+    public TestResult testReflectionStatsUntypedMethodWrap()
+    {
+        string caseName = "testReflectionStatsUntypedMethodWrap: ";
+        LOG("*************" + caseName);
+        TestResult result;
+
+        // a MethodWrap built with the constructor taking no type has no stat to record into
+        var translator = ObjectTranslatorPool.Instance.Find(luaEnv.L);
+        var overload = new OverloadMethodWrap(translator, typeof(Math), typeof(Math).GetMethod("Max", new Type[] { typeof(int), typeof(int) }));
+        overload.Init(new ObjectCheckers(translator), new ObjectCasters(translator));
+        var wrap = new MethodWrap("Max", new List<OverloadMethodWrap> { overload }, false);
+        XLua.LuaDLL.lua_CSFunction call = wrap.Call;
+        XLua.LuaDLL.Lua.lua_pushstdcallcfunction(luaEnv.L, call);
+        XLua.LuaDLL.Lua.xlua_setglobal(luaEnv.L, "untyped_wrap_max");
+
+        ReflectionStats.Enabled = true;
+        int max;
+        try
+        {
+            max = Convert.ToInt32(luaEnv.DoString("return untyped_wrap_max(3, 7)")[0]);
+        }
+        finally
+        {
+            ReflectionStats.Enabled = false;
+            luaEnv.DoString("untyped_wrap_max = nil");
+        }
+        GC.KeepAlive(call);
+
+        if (max == 7)
+        {
+            setResult(true, "pass", out result);
+        }
+        else
+        {
+            setResult(false, "unexpected result " + max, out result);
+        }
+
+        LOG(caseName + result.ToString());
+        return result;
+    }
+
+    public TestResult testDelegateBridgeRejectsValues()
+    {
+        string caseName = "testDelegateBridgeRejectsValues: ";
+        LOG("*************" + caseName);
+        TestResult result;
+
+        var L = luaEnv.L;
+        var translator = ObjectTranslatorPool.Instance.Find(L);
+        int oldTop = XLua.LuaDLL.Lua.lua_gettop(L);
+        XLua.LuaDLL.Lua.lua_pushnil(L);
+        XLua.LuaDLL.Lua.lua_pushnumber(L, 1);
+        XLua.LuaDLL.Lua.lua_pushstring(L, "handler");
+        XLua.LuaDLL.Lua.lua_pushboolean(L, true);
+        bool rejected = true;
+        for (int i = 1; i <= 4; i++)
+        {
+            rejected = rejected && translator.CreateDelegateBridge(L, typeof(Action), oldTop + i) == null;
+        }
+        XLua.LuaDLL.Lua.lua_settop(L, oldTop);
+        luaEnv.DoString("reject_values_called = false function reject_values_cb() reject_values_called = true end");
+        var callback = luaEnv.Global.Get<Action>("reject_values_cb");
+        callback();
+
+        if (rejected && luaEnv.Global.Get<bool>("reject_values_called"))
+        {
+            setResult(true, "pass", out result);
+        }
+        else
+        {
+            setResult(false, "a non function value got a delegate bridge", out result);
+        }
+
+        LOG(caseName + result.ToString());
+        return result;
+    }
+
+    public TestResult testLuaRefScopeOtherThread()
+    {
+        string caseName = "testLuaRefScopeOtherThread: ";
+        LOG("*************" + caseName);
+        TestResult result;
+
+        luaEnv.DoString("scope_weak = setmetatable({}, { __mode = 'v' })");
+        LuaTable fromOther = null;
+        bool beginRejected = false;
+        using (var scope = luaEnv.BeginRefScope())
+        {
+            var thread = new System.Threading.Thread(() =>
+            {
+                fromOther = luaEnv.DoString("local t = {} scope_weak[1] = t return t")[0] as LuaTable;
+                try
+                {
+                    luaEnv.BeginRefScope().Dispose();
+                }
+                catch (InvalidOperationException)
+                {
+                    beginRejected = true;
+                }
+            });
+            thread.Start();
+            thread.Join();
+        }
+        luaEnv.FullGc();
+        // the table was created on another thread, so the scope must not have released it
+        bool alive = (bool)luaEnv.DoString("return scope_weak[1] ~= nil")[0] && fromOther.Length == 0;
+        fromOther.Dispose();
+        luaEnv.FullGc();
+        bool released = (bool)luaEnv.DoString("return scope_weak[1] == nil")[0];
+
+        if (alive && released && beginRejected)
+        {
+            setResult(true, "pass", out result);
+        }
+        else
+        {
+            setResult(false, "alive: " + alive + ", released: " + released + ", begin rejected: " + beginRejected, out result);
+        }
+        luaEnv.DoString("scope_weak = nil");
+
+        LOG(caseName + result.ToString());
+        return result;
+    }
+
+    public TestResult testLuaTableCopyFrom()
+    {
+        string caseName = "testLuaTableCopyFrom: ";
+        LOG("*************" + caseName);
+        TestResult result;
+
+        LuaTable table = luaEnv.DoString("return setmetatable({}, { __newindex = function() error('rawset expected') end })")[0] as LuaTable;
+        LuaFunction check = luaEnv.DoString(@"
+            return function(t, ...)
+                local n = select('#', ...)
+                if #t ~= n then return false end
+                for i = 1, n do
+                    if t[i] ~= select(i, ...) then return false end
+                end
+                return true
+            end")[0] as LuaFunction;
+
+        table.CopyFrom(new double[] { 1.5, 2, 3 });
+        bool doublesOk = (bool)check.Call(table, 1.5, 2, 3)[0];
+        table.CopyFrom(new float[] { 0.5f });
+        bool floatsOk = (bool)check.Call(table, 0.5, 2, 3)[0];
+        table.CopyFrom(new int[] { 7, 8, 9, 10 });
+        bool intsOk = (bool)check.Call(table, 7, 8, 9, 10)[0];
+        table.CopyFrom(new long[] { 12345678901L, -2 });
+        bool longsOk = table.Get<int, long>(1) == 12345678901L && table.Get<int, long>(2) == -2 && table.Get<int, int>(3) == 9;
+        table.CopyFrom(new string[] { "a", "b" });
+        bool stringsOk = (bool)check.Call(table, "a", "b", 9, 10)[0];
+
+        var back = new int[4];
+        table.CopyFrom(new int[] { 1, 2, 3, 4 });
+        int count = table.CopyTo(back);
+
+        if (doublesOk && floatsOk && intsOk && longsOk && stringsOk && count == 4 && back[3] == 4)
+        {
+            setResult(true, "pass", out result);
+        }
+        else
+        {
+            setResult(false, "doubles: " + doublesOk + ", floats: " + floatsOk + ", ints: " + intsOk + ", longs: " + longsOk
+                + ", strings: " + stringsOk + ", count: " + count, out result);
+        }
+        check.Dispose();
+        table.Dispose();
+
+        LOG(caseName + result.ToString());
+        return result;
+    }
+
+#if XLUA_GENERAL
+    // the generator is only compiled into the general build, the lua cases skip these when they are missing
+    public class GenSigRef { public void Foo(ref int a) { } }
+    public class GenSigOut { public void Foo(out int a) { a = 0; } }
+    public class GenSigDefault1 { public void Foo(int a = 1) { } }
+    public class GenSigDefault2 { public void Foo(int a = 2) { } }
+    public class GenSigRequired { public void Foo(int a) { } }
+    public class GenSigArray { public void Foo(int[] a) { } }
+    public class GenSigParams { public void Foo(params int[] a) { } }
+
+    public TestResult testGenMemberSignature()
+    {
+        string caseName = "testGenMemberSignature: ";
+        LOG("*************" + caseName);
+        TestResult result;
+
+        Func<Type, string> sig = type => CSObjectWrapEditor.Generator.memberSignature(type.GetMethod("Foo"));
+        bool refOut = sig(typeof(GenSigRef)) != sig(typeof(GenSigOut));
+        bool defaults = sig(typeof(GenSigDefault1)) != sig(typeof(GenSigDefault2));
+        bool optional = sig(typeof(GenSigDefault1)) != sig(typeof(GenSigRequired));
+        bool paramArray = sig(typeof(GenSigArray)) != sig(typeof(GenSigParams));
+
+        if (refOut && defaults && optional && paramArray)
+        {
+            setResult(true, "pass", out result);
+        }
+        else
+        {
+            setResult(false, "ref/out: " + refOut + ", defaults: " + defaults + ", optional: " + optional + ", params: " + paramArray, out result);
+        }
+
+        LOG(caseName + result.ToString());
+        return result;
+    }
+
+    [LuaCallCSharp]
+    public class GenManifestTarget
+    {
+        public int Value;
+    }
+
+    static CSObjectWrapEditor.XLuaTemplate genTemplate(string name, string file)
+    {
+        return new CSObjectWrapEditor.XLuaTemplate { name = name, text = File.ReadAllText("../Assets/XLua/Src/Editor/Template/" + file) };
+    }
+
+    static Dictionary<string, string> genWithCommon(string path, string commonSuffix)
+    {
+        var templates = new CSObjectWrapEditor.XLuaTemplates
+        {
+            LuaClassWrap = genTemplate("LuaClassWrap", "LuaClassWrap.tpl.txt"),
+            LuaDelegateBridge = genTemplate("LuaDelegateBridge", "LuaDelegateBridge.tpl.txt"),
+            LuaDelegateWrap = genTemplate("LuaDelegateWrap", "LuaDelegateWrap.tpl.txt"),
+            LuaEnumWrap = genTemplate("LuaEnumWrap", "LuaEnumWrap.tpl.txt"),
+            LuaInterfaceBridge = genTemplate("LuaInterfaceBridge", "LuaInterfaceBridge.tpl.txt"),
+            LuaRegister = genTemplate("LuaRegister", "LuaRegister.tpl.txt"),
+            LuaWrapPusher = genTemplate("LuaWrapPusher", "LuaWrapPusher.tpl.txt"),
+            PackUnpack = genTemplate("PackUnpack", "PackUnpack.tpl.txt"),
+            TemplateCommon = genTemplate("TemplateCommon", "TemplateCommon.lua.txt"),
+        };
+        templates.TemplateCommon.text += commonSuffix;
+        CSObjectWrapEditor.GeneratorConfig.common_path = path;
+        CSObjectWrapEditor.Generator.GenAll(templates, new Type[] { typeof(GenManifestTarget) });
+        var manifest = new Dictionary<string, string>();
+        foreach (var line in File.ReadAllLines(path + ".xlua_gen_manifest"))
+        {
+            int sep = line.IndexOf('\t');
+            manifest[line.Substring(0, sep)] = line.Substring(sep + 1);
+        }
+        return manifest;
+    }
+
+    public TestResult testGenManifestTemplateCommon()
+    {
+        string caseName = "testGenManifestTemplateCommon: ";
+        LOG("*************" + caseName);
+        TestResult result;
+
+        string path = Path.Combine(Path.GetTempPath(), "xlua_gen_manifest_test_" + Guid.NewGuid().ToString("N")) + "/";
+        string oldPath = CSObjectWrapEditor.GeneratorConfig.common_path;
+        try
+        {
+            var first = genWithCommon(path, "");
+            var same = genWithCommon(path, "");
+            // a change of TemplateCommon alone must invalidate every per type file
+            var changed = genWithCommon(path, "\n-- changed\n");
+
+            bool stable = first.Count == same.Count;
+            int typed = 0;
+            bool invalidated = true;
+            foreach (var kv in first)
+            {
+                string hash;
+                stable = stable && same.TryGetValue(kv.Key, out hash) && hash == kv.Value;
+                if (kv.Value != "")
+                {
+                    typed++;
+                    invalidated = invalidated && changed.TryGetValue(kv.Key, out hash) && hash != kv.Value;
+                }
+            }
+            invalidated = invalidated && typed > 0;
+
+            if (stable && invalidated)
+            {
+                setResult(true, "pass", out result);
+            }
+            else
+            {
+                setResult(false, "stable: " + stable + ", per type files: " + typed + ", invalidated: " + invalidated, out result);
+            }
+        }
+        finally
+        {
+            CSObjectWrapEditor.GeneratorConfig.common_path = oldPath;
+            if (Directory.Exists(path))
+            {
+                Directory.Delete(path, true);
+            }
+        }
+
+        LOG(caseName + result.ToString());
+        return result;
+    }
+#endif
+
+    public TestResult testLuaWorkerPoolSubmitWhileDisposing()
+    {
+        string caseName = "testLuaWorkerPoolSubmitWhileDisposing: ";
+        LOG("*************" + caseName);
+        TestResult result;
+
+        int lost = 0, submitted = 0;
+        for (int round = 0; round < 20; round++)
+        {
+            var pool = new LuaWorkerPool(2, env => env.DoString("function nop() end"));
+            var jobs = new List<LuaJob>();
+            var started = new System.Threading.ManualResetEvent(false);
+            var submitter = new System.Threading.Thread(() =>
+            {
+                try
+                {
+                    while (true)
+                    {
+                        jobs.Add(pool.Submit("nop"));
+                        started.Set();
+                    }
+                }
+                catch (ObjectDisposedException)
+                {
+                }
+            });
+            submitter.Start();
+            started.WaitOne();
+            pool.Dispose();
+            submitter.Join();
+            // the workers are gone, every accepted job must have been run or failed by now
+            foreach (var job in jobs)
+            {
+                if (!job.IsDone) lost++;
+            }
+            submitted += jobs.Count;
+        }
+
+        if (lost == 0 && submitted > 0)
+        {
+            setResult(true, "pass", out result);
+        }
+        else
+        {
+            setResult(false, "jobs never completed: " + lost + " of " + submitted, out result);
+        }
+
+        LOG(caseName + result.ToString());
+        return result;
+    }
+
+    public TestResult testTemplateBytecodeCacheFallback()
+    {
+        string caseName = "testTemplateBytecodeCacheFallback: ";
+        LOG("*************" + caseName);
+        TestResult result;
+
+        string oldPath = XLua.TemplateEngine.LuaTemplate.BytecodeCachePath;
+        string path = Path.Combine(Path.GetTempPath(), "xlua_template_cache_test_" + Guid.NewGuid().ToString("N"));
+        XLua.TemplateEngine.LuaTemplate.BytecodeCachePath = path;
+        try
+        {
+            string snippet = "<%=name%>:<%for i = 1, 3 do%><%=i%><%end%>";
+            var parameters = luaEnv.NewTable();
+            parameters.Set("name", "tpl");
+            parameters.Set("tostring", luaEnv.Global.Get<LuaFunction>("tostring"));
+            parameters.Set("table", luaEnv.Global.Get<LuaTable>("table"));
+
+            var compiled = XLua.TemplateEngine.LuaTemplate.Compile(luaEnv, snippet);
+            string fresh = XLua.TemplateEngine.LuaTemplate.Execute(compiled, parameters);
+            var files = Directory.GetFiles(path, "*.luac");
+            var cached = XLua.TemplateEngine.LuaTemplate.Compile(luaEnv, snippet);
+            string fromCache = XLua.TemplateEngine.LuaTemplate.Execute(cached, parameters);
+            // a chunk another vm dumped fails to load, it is compiled from source again
+            File.WriteAllBytes(files[0], new byte[] { 0x1b, (byte)'L', (byte)'u', (byte)'a', 0xff, 0xff });
+            var recompiled = XLua.TemplateEngine.LuaTemplate.Compile(luaEnv, snippet);
+            string fromSource = XLua.TemplateEngine.LuaTemplate.Execute(recompiled, parameters);
+
+            if (fresh == "tpl:123" && files.Length == 1 && fromCache == fresh && fromSource == fresh)
+            {
+                setResult(true, "pass", out result);
+            }
+            else
+            {
+                setResult(false, "fresh: " + fresh + ", files: " + files.Length + ", cached: " + fromCache + ", recompiled: " + fromSource, out result);
+            }
+            compiled.Dispose();
+            cached.Dispose();
+            recompiled.Dispose();
+            parameters.Dispose();
+        }
+        finally
+        {
+            XLua.TemplateEngine.LuaTemplate.BytecodeCachePath = oldPath;
+            if (Directory.Exists(path))
+            {
+                Directory.Delete(path, true);
+            }
+        }
+
+        LOG(caseName + result.ToString());
+        return result;
+    }
+
 }
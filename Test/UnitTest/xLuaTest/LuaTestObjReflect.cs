@@ -221,6 +221,51 @@ public class LuaTestObjReflect
 		return x.ToString ();
 	}
 
+	public static string OverloadShapeFunc(int x)
+	{
+		return "int";
+	}
+
+	public static string OverloadShapeFunc(string x)
+	{
+		return "string";
+	}
+
+	public static string OverloadShapeFunc(LuaTestObjReflect x)
+	{
+		return "obj";
+	}
+
+	public static string OverloadShapeFunc(int[] x)
+	{
+		return "int[]";
+	}
+
+	public static string OverloadShapeFunc(string[] x)
+	{
+		return "string[]";
+	}
+
+	public static int CompiledRefFunc(int a, ref int b, out string c)
+	{
+		b += a;
+		c = "r" + b;
+		return a * 2;
+	}
+
+	public static int CompiledDefaultFunc(int a, HasConstructStructReflect s = default(HasConstructStructReflect))
+	{
+		return a + s.x;
+	}
+
+	public static void CompiledThrowFunc(int a)
+	{
+		if (a > 20)
+		{
+			throw new InvalidOperationException("compiled " + a);
+		}
+	}
+
 	public static ulong ulX1 = 1;
 	public static ulong ulX2 = 1;
 	public static long lY1 = 1;
@@ -712,6 +757,12 @@ public struct HasConstructStructReflect{
 		this.y = y;
 		this.z = z;
 	}
+
+	public int Move(int dx)
+	{
+		x += dx;
+		return x;
+	}
 }
 
 public class CClassReflect
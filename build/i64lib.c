@@ -38,6 +38,7 @@
 #if LUA_VERSION_NUM == 501
 
 #define INT64_META_REF 8
+#define INT64_INTERN_REF 9
 
 enum IntegerType {
 	Int,
@@ -54,13 +55,46 @@ typedef struct {
 	} data;
 } Integer64;
 
-LUALIB_API void lua_pushint64(lua_State* L, int64_t n) {
-	Integer64* p = (Integer64*)lua_newuserdata(L, sizeof(Integer64));
+/* when registry[INT64_INTERN_REF] holds a weak-valued table, equal values share one userdata.
+   the slot holds false otherwise, never nil, so luaL_ref can not hand it out */
+static void int64_push(lua_State* L, int8_t type, uint64_t bits) {
+	Integer64* p;
+	char key[sizeof(uint64_t) + 1];
+	int interned;
+	
+	lua_rawgeti(L, LUA_REGISTRYINDEX, INT64_INTERN_REF);
+	interned = lua_istable(L, -1);
+	if (interned) {
+		key[0] = (char)type;
+		memcpy(key + 1, &bits, sizeof(uint64_t));
+		lua_pushlstring(L, key, sizeof(key));
+		lua_rawget(L, -2);
+		if (!lua_isnil(L, -1)) {
+			lua_remove(L, -2);
+			return;
+		}
+		lua_pop(L, 1);
+	} else {
+		lua_pop(L, 1);
+	}
+	
+	p = (Integer64*)lua_newuserdata(L, sizeof(Integer64));
 	p->fake_id = -1;
-	p->data.i64 = n;
-	p->type = Int;
+	p->data.u64 = bits;
+	p->type = type;
 	lua_rawgeti(L, LUA_REGISTRYINDEX, INT64_META_REF);
-	lua_setmetatable(L, -2);            
+	lua_setmetatable(L, -2);
+	
+	if (interned) {
+		lua_pushlstring(L, key, sizeof(key));
+		lua_pushvalue(L, -2);
+		lua_rawset(L, -4);
+		lua_remove(L, -2);
+	}
+}
+
+LUALIB_API void lua_pushint64(lua_State* L, int64_t n) {
+	int64_push(L, Int, (uint64_t)n);
 }
 
 LUALIB_API int lua_isint64(lua_State* L, int pos) {
@@ -119,12 +153,7 @@ LUALIB_API int64_t lua_toint64(lua_State* L, int pos) {
 
 #if defined(UINT_ESPECIALLY)
 LUALIB_API void lua_pushuint64(lua_State* L, uint64_t n) {
-	Integer64* p = (Integer64*)lua_newuserdata(L, sizeof(Integer64));
-	p->fake_id = -1;
-	p->data.u64 = n;
-	p->type = UInt;
-	lua_rawgeti(L, LUA_REGISTRYINDEX, INT64_META_REF);
-	lua_setmetatable(L, -2);            
+	int64_push(L, UInt, n);
 }
 
 
@@ -373,6 +402,24 @@ static int int64_tostring(lua_State* L) {
     return 1;
 }
 
+static int int64_intern(lua_State* L) {
+	if (lua_toboolean(L, 1)) {
+		lua_rawgeti(L, LUA_REGISTRYINDEX, INT64_INTERN_REF);
+		if (lua_istable(L, -1)) {
+			return 0;
+		}
+		lua_newtable(L);
+		lua_newtable(L);
+		lua_pushstring(L, "v");
+		lua_setfield(L, -2, "__mode");
+		lua_setmetatable(L, -2);
+	} else {
+		lua_pushboolean(L, 0);
+	}
+	lua_rawseti(L, LUA_REGISTRYINDEX, INT64_INTERN_REF);
+	return 0;
+}
+
 #endif
 
 #if LUA_VERSION_NUM == 503
@@ -398,6 +445,10 @@ LUALIB_API int64_t lua_toint64(lua_State* L, int pos) {
 LUALIB_API uint64_t lua_touint64(lua_State* L, int pos) {
 	return lua_tointeger(L, pos);
 }
+
+static int int64_intern(lua_State* L) {
+	return 0;
+}
 #endif
 
 static int uint64_tostring(lua_State* L) {
@@ -487,6 +538,9 @@ LUALIB_API int luaopen_i64lib(lua_State* L)
     lua_setfield(L, -2, "__le");
 	
 	lua_rawseti(L, LUA_REGISTRYINDEX, INT64_META_REF);
+
+	lua_pushboolean(L, 0);
+	lua_rawseti(L, LUA_REGISTRYINDEX, INT64_INTERN_REF);
 #endif
     lua_newtable(L);
 	
@@ -505,6 +559,9 @@ LUALIB_API int luaopen_i64lib(lua_State* L)
 	lua_pushcfunction(L, uint64_parse);
 	lua_setfield(L, -2, "parse");
 	
+	lua_pushcfunction(L, int64_intern);
+	lua_setfield(L, -2, "intern");
+	
 	lua_setglobal(L, "uint64");
 	return 0;
 }
@@ -40,7 +40,7 @@ LUA_API int xlua_get_registry_index() {
 }
 
 LUA_API int xlua_get_lib_version() {
-	return 105;
+	return 112;
 }
 
 LUA_API int xlua_tocsobj_safe(lua_State *L,int index) {
@@ -211,9 +211,45 @@ static int c_lua_gettable(lua_State* L) {
     return 1;
 }
 
+/* whether the metatable of the value at idx has the field event, rawget/rawset give the same result as get/set when it has not */
+static int has_metamethod(lua_State* L, int idx, const char *event) {
+	int has;
+	if (!lua_getmetatable(L, idx)) {
+		return 0;
+	}
+	lua_pushstring(L, event);
+	lua_rawget(L, -2);
+	has = !lua_isnil(L, -1);
+	lua_pop(L, 2);
+	return has;
+}
+
+/* keys lua_rawset would raise an error for, those go through the protected path */
+static int is_raw_key(lua_State* L, int idx) {
+	int type = lua_type(L, idx);
+	if (type == LUA_TNIL) {
+		return 0;
+	}
+	if (type == LUA_TNUMBER) {
+		lua_Number n = lua_tonumber(L, idx);
+		return n == n;
+	}
+	return 1;
+}
+
 LUA_API int xlua_pgettable(lua_State* L, int idx) {
     int top = lua_gettop(L);
     idx = lua_absindex(L, idx);
+    if (lua_type(L, idx) == LUA_TTABLE) {
+        /* __index only runs for absent keys, a raw hit or a table without __index needs no pcall */
+        lua_pushvalue(L, top);
+        lua_rawget(L, idx);
+        if (!lua_isnil(L, -1) || !has_metamethod(L, idx, "__index")) {
+            lua_remove(L, top);
+            return 0;
+        }
+        lua_pop(L, 1);
+    }
     lua_pushcfunction(L, c_lua_gettable);
     lua_pushvalue(L, idx);
     lua_pushvalue(L, top);
@@ -263,6 +299,20 @@ static int c_lua_settable(lua_State* L) {
 LUA_API int xlua_psettable(lua_State* L, int idx) {
     int top = lua_gettop(L);
     idx = lua_absindex(L, idx);
+    if (lua_type(L, idx) == LUA_TTABLE && is_raw_key(L, top - 1)) {
+        /* __newindex only runs for absent keys */
+        int raw = !has_metamethod(L, idx, "__newindex");
+        if (!raw) {
+            lua_pushvalue(L, top - 1);
+            lua_rawget(L, idx);
+            raw = !lua_isnil(L, -1);
+            lua_pop(L, 1);
+        }
+        if (raw) {
+            lua_rawset(L, idx);
+            return 0;
+        }
+    }
     lua_pushcfunction(L, c_lua_settable);
     lua_pushvalue(L, idx);
     lua_pushvalue(L, top - 1);
@@ -310,6 +360,334 @@ LUA_API int xlua_psettable_bypath(lua_State* L, int idx, const char *path) {
     return lua_pcall(L, 3, 0, 0);
 }
 
+/* a path resolved once (LuaPath) is a table of its key strings, keys[0] is the whole path for error messages.
+   the walks below start at key i of the value at 1, with the same semantics as the bypath versions */
+static int c_lua_gettable_bykeys(lua_State* L) {
+	int i = (int)lua_tointeger(L, 3);
+	int n = (int)xlua_objlen(L, 2);
+	lua_pushvalue(L, 1);
+	for (; i <= n; i++) {
+		if (i > 1 && lua_type(L, -1) != LUA_TTABLE) { // not found in path
+			lua_pop(L, 1);
+			lua_pushnil(L);
+			break;
+		}
+		lua_rawgeti(L, 2, i);
+		lua_gettable(L, -2);
+		lua_remove(L, -2);
+	}
+	return 1;
+}
+
+LUA_API int xlua_pgettable_bykeys(lua_State* L, int idx, int keysRef) {
+	int i, n;
+	int top = lua_gettop(L);
+	idx = lua_absindex(L, idx);
+	lua_rawgeti(L, LUA_REGISTRYINDEX, keysRef);
+	n = (int)xlua_objlen(L, top + 1);
+	lua_pushvalue(L, idx);
+	/* raw walk while no __index can run, like xlua_pgettable */
+	for (i = 1; i <= n; i++) {
+		if (lua_type(L, -1) != LUA_TTABLE) {
+			if (i == 1) {
+				break;
+			}
+			lua_pop(L, 1); // not found in path
+			lua_pushnil(L);
+			lua_remove(L, top + 1);
+			return 0;
+		}
+		lua_rawgeti(L, top + 1, i);
+		lua_rawget(L, -2);
+		if (lua_isnil(L, -1) && has_metamethod(L, -2, "__index")) {
+			lua_pop(L, 1);
+			break;
+		}
+		lua_remove(L, -2);
+	}
+	if (i > n) {
+		lua_remove(L, top + 1);
+		return 0;
+	}
+	lua_pushcfunction(L, c_lua_gettable_bykeys);
+	lua_pushvalue(L, top + 2);
+	lua_pushvalue(L, top + 1);
+	lua_pushinteger(L, i);
+	lua_remove(L, top + 1);
+	lua_remove(L, top + 1);
+	return lua_pcall(L, 3, 1, 0);
+}
+
+static int c_lua_settable_bykeys(lua_State* L) {
+	int i = (int)lua_tointeger(L, 3);
+	int n = (int)xlua_objlen(L, 2);
+	lua_pushvalue(L, 1);
+	for (;; i++) {
+		if (i > 1 && lua_type(L, -1) != LUA_TTABLE) {
+			lua_rawgeti(L, 2, 0);
+			return luaL_error(L, "can not set value to %s", lua_tostring(L, -1));
+		}
+		if (i >= n) {
+			break;
+		}
+		lua_rawgeti(L, 2, i);
+		lua_gettable(L, -2);
+		lua_remove(L, -2);
+	}
+	lua_rawgeti(L, 2, n);
+	lua_pushvalue(L, 4);
+	lua_settable(L, -3);
+	return 0;
+}
+
+LUA_API int xlua_psettable_bykeys(lua_State* L, int idx, int keysRef) {
+	int i, n;
+	int top = lua_gettop(L);
+	idx = lua_absindex(L, idx);
+	lua_rawgeti(L, LUA_REGISTRYINDEX, keysRef);
+	n = (int)xlua_objlen(L, top + 1);
+	lua_pushvalue(L, idx);
+	for (i = 1; i < n; i++) {
+		if (lua_type(L, -1) != LUA_TTABLE) {
+			break;
+		}
+		lua_rawgeti(L, top + 1, i);
+		lua_rawget(L, -2);
+		if (lua_isnil(L, -1) && has_metamethod(L, -2, "__index")) {
+			lua_pop(L, 1);
+			break;
+		}
+		lua_remove(L, -2);
+	}
+	if (i == n && lua_type(L, -1) == LUA_TTABLE) {
+		/* __newindex only runs for absent keys, like xlua_psettable */
+		int raw = !has_metamethod(L, -1, "__newindex");
+		if (!raw) {
+			lua_rawgeti(L, top + 1, n);
+			lua_rawget(L, -2);
+			raw = !lua_isnil(L, -1);
+			lua_pop(L, 1);
+		}
+		if (raw) {
+			lua_rawgeti(L, top + 1, n);
+			lua_pushvalue(L, top);
+			lua_rawset(L, -3);
+			lua_settop(L, top - 1);
+			return 0;
+		}
+	}
+	lua_pushcfunction(L, c_lua_settable_bykeys);
+	lua_pushvalue(L, top + 2);
+	lua_pushvalue(L, top + 1);
+	lua_pushinteger(L, i);
+	lua_pushvalue(L, top);
+	lua_remove(L, top);
+	lua_remove(L, top);
+	lua_remove(L, top);
+	return lua_pcall(L, 4, 0, 0);
+}
+
+/* bulk copy between t[1..len] and a caller buffer, rawget stops at the first non number and returns its offset */
+#define RAW_ARRAY_ACCESS(name, type, tofunc, pushfunc) \
+	LUA_API int xlua_rawget_##name(lua_State *L, int idx, type *buff, int len) { \
+		int i; \
+		idx = lua_absindex(L, idx); \
+		for (i = 0; i < len; i++) { \
+			lua_rawgeti(L, idx, i + 1); \
+			if (lua_type(L, -1) != LUA_TNUMBER) { \
+				lua_pop(L, 1); \
+				return i; \
+			} \
+			buff[i] = (type)tofunc(L, -1); \
+			lua_pop(L, 1); \
+		} \
+		return len; \
+	} \
+	LUA_API void xlua_rawset_##name(lua_State *L, int idx, type *buff, int len) { \
+		int i; \
+		idx = lua_absindex(L, idx); \
+		for (i = 0; i < len; i++) { \
+			pushfunc(L, buff[i]); \
+			lua_rawseti(L, idx, i + 1); \
+		} \
+	}
+
+RAW_ARRAY_ACCESS(doubles, double, lua_tonumber, lua_pushnumber)
+RAW_ARRAY_ACCESS(floats, float, lua_tonumber, lua_pushnumber)
+RAW_ARRAY_ACCESS(ints, int, lua_tointeger, lua_pushinteger)
+RAW_ARRAY_ACCESS(longs, int64_t, lua_toint64, lua_pushint64)
+
+/* releases count registry refs in one call, LuaEnv.Tick batches the refs of the collected LuaBase objects */
+LUA_API void xlua_unref_batch(lua_State *L, const int *refs, int count) {
+	int i;
+	for (i = 0; i < count; i++) {
+		luaL_unref(L, LUA_REGISTRYINDEX, refs[i]);
+	}
+}
+
+/* table snapshot: a schema built by TableSnapshot on the c# side drives a walk of a whole table into one flat buffer.
+   a descriptor is {key, kind, sub}, sub is the array of field descriptors of an object or the element descriptor of an array.
+   every value is written as a presence byte (0 for nil) followed by its payload, in the order of the schema */
+#define SNAPSHOT_BOOLEAN 1
+#define SNAPSHOT_INTEGER 2
+#define SNAPSHOT_NUMBER 3
+#define SNAPSHOT_STRING 4
+#define SNAPSHOT_OBJECT 5
+#define SNAPSHOT_ARRAY 6
+
+#define SNAPSHOT_MAX_DEPTH 64
+#define SNAPSHOT_BUFFER_SLOT 3
+
+typedef struct {
+	unsigned char *data;
+	size_t size;
+	size_t capacity;
+} SnapshotBuffer;
+
+/* the buffer is a userdata kept at SNAPSHOT_BUFFER_SLOT, so an error raised in the middle of the walk leaks nothing */
+static void snapshot_write(lua_State *L, SnapshotBuffer *sb, const void *p, size_t len) {
+	if (sb->size + len > sb->capacity) {
+		size_t capacity = sb->capacity * 2;
+		unsigned char *data;
+		if (capacity < sb->size + len) {
+			capacity = sb->size + len;
+		}
+		data = (unsigned char *)lua_newuserdata(L, capacity);
+		memcpy(data, sb->data, sb->size);
+		lua_replace(L, SNAPSHOT_BUFFER_SLOT);
+		sb->data = data;
+		sb->capacity = capacity;
+	}
+	memcpy(sb->data + sb->size, p, len);
+	sb->size += len;
+}
+
+static int snapshot_error(lua_State *L, int desc, const char *expected) {
+	lua_rawgeti(L, desc, 1);
+	return luaL_error(L, "snapshot field %s: %s expected, got %s",
+		lua_type(L, -1) == LUA_TSTRING ? lua_tostring(L, -1) : "[]", expected, luaL_typename(L, -2));
+}
+
+/* writes the value on the top of the stack as described by the descriptor at desc, pops nothing */
+static void snapshot_value(lua_State *L, SnapshotBuffer *sb, int desc, int depth) {
+	unsigned char present = !lua_isnil(L, -1);
+	int kind;
+	snapshot_write(L, sb, &present, 1);
+	if (!present) {
+		return;
+	}
+	if (depth >= SNAPSHOT_MAX_DEPTH) {
+		luaL_error(L, "table nested too deep to snapshot");
+	}
+	luaL_checkstack(L, 4, "snapshot");
+	lua_rawgeti(L, desc, 2);
+	kind = (int)lua_tointeger(L, -1);
+	lua_pop(L, 1);
+	switch (kind) {
+		case SNAPSHOT_BOOLEAN: {
+			unsigned char b = (unsigned char)lua_toboolean(L, -1);
+			snapshot_write(L, sb, &b, 1);
+			break;
+		}
+		case SNAPSHOT_INTEGER: {
+			int64_t n;
+			if (lua_type(L, -1) == LUA_TNUMBER) {
+				n = lua_isinteger(L, -1) ? (int64_t)lua_tointeger(L, -1) : (int64_t)lua_tonumber(L, -1);
+			} else if (lua_isint64(L, -1)) {
+				n = lua_toint64(L, -1);
+			} else {
+				snapshot_error(L, desc, "integer");
+				return;
+			}
+			snapshot_write(L, sb, &n, sizeof(n));
+			break;
+		}
+		case SNAPSHOT_NUMBER: {
+			double d;
+			if (lua_type(L, -1) != LUA_TNUMBER) {
+				snapshot_error(L, desc, "number");
+				return;
+			}
+			d = (double)lua_tonumber(L, -1);
+			snapshot_write(L, sb, &d, sizeof(d));
+			break;
+		}
+		case SNAPSHOT_STRING: {
+			size_t len;
+			const char *s;
+			int32_t len32;
+			if (lua_type(L, -1) != LUA_TSTRING) {
+				snapshot_error(L, desc, "string");
+				return;
+			}
+			s = lua_tolstring(L, -1, &len);
+			len32 = (int32_t)len;
+			snapshot_write(L, sb, &len32, sizeof(len32));
+			snapshot_write(L, sb, s, len);
+			break;
+		}
+		case SNAPSHOT_OBJECT: {
+			int i, n, value = lua_gettop(L);
+			if (lua_type(L, value) != LUA_TTABLE) {
+				snapshot_error(L, desc, "table");
+				return;
+			}
+			lua_rawgeti(L, desc, 3);
+			n = (int)xlua_objlen(L, -1);
+			for (i = 1; i <= n; i++) {
+				lua_rawgeti(L, value + 1, i);
+				lua_rawgeti(L, -1, 1);
+				lua_rawget(L, value);
+				snapshot_value(L, sb, value + 2, depth + 1);
+				lua_pop(L, 2);
+			}
+			lua_pop(L, 1);
+			break;
+		}
+		case SNAPSHOT_ARRAY: {
+			int i, value = lua_gettop(L);
+			int32_t n;
+			if (lua_type(L, value) != LUA_TTABLE) {
+				snapshot_error(L, desc, "table");
+				return;
+			}
+			n = (int32_t)xlua_objlen(L, value);
+			snapshot_write(L, sb, &n, sizeof(n));
+			lua_rawgeti(L, desc, 3);
+			for (i = 1; i <= n; i++) {
+				lua_rawgeti(L, value, i);
+				snapshot_value(L, sb, value + 1, depth + 1);
+				lua_pop(L, 1);
+			}
+			lua_pop(L, 1);
+			break;
+		}
+		default:
+			luaL_error(L, "invalid snapshot schema");
+	}
+}
+
+static int c_xlua_snapshot(lua_State *L) {
+	SnapshotBuffer sb;
+	sb.capacity = 256;
+	sb.size = 0;
+	sb.data = (unsigned char *)lua_newuserdata(L, sb.capacity);
+	lua_pushvalue(L, 1);
+	snapshot_value(L, &sb, 2, 0);
+	lua_pop(L, 1);
+	lua_pushinteger(L, (lua_Integer)sb.size);
+	return 2;
+}
+
+/* pushes the buffer userdata and its used length, the buffer lives until they are popped */
+LUA_API int xlua_snapshot(lua_State *L, int idx, int schemaRef) {
+	idx = lua_absindex(L, idx);
+	lua_pushcfunction(L, c_xlua_snapshot);
+	lua_pushvalue(L, idx);
+	lua_rawgeti(L, LUA_REGISTRYINDEX, schemaRef);
+	return lua_pcall(L, 2, 2, 0);
+}
+
 static int c_lua_getglobal(lua_State* L) {
 	lua_getglobal(L, lua_tostring(L, 1));
 	return 1;
@@ -837,6 +1215,14 @@ LUA_API void *xlua_pushstruct(lua_State *L, unsigned int size, int meta_ref) {
 	return css;
 }
 
+/* plain struct buffer without metatable, used to hold a packed array of c# structs */
+LUA_API void *xlua_pushstructbuffer(lua_State *L, unsigned int size) {
+	CSharpStruct *css = (CSharpStruct *)lua_newuserdata(L, size + sizeof(int) + sizeof(unsigned int));
+	css->fake_id = -1;
+	css->len = size;
+	return css;
+}
+
 LUA_API void xlua_pushcstable(lua_State *L, unsigned int size, int meta_ref) {
 	lua_createtable(L, 0, size);
     lua_rawgeti(L, LUA_REGISTRYINDEX, meta_ref);
@@ -881,6 +1267,61 @@ LUA_API int xlua_gettypeid(lua_State *L, int idx) {
 	return type_id;
 }
 
+/* pushes a struct buffer of len elements of size bytes and copies t[1..len] into it while they are structs of type_id,
+   returns how many were copied, the caller unpacks them and reads the rest one by one */
+LUA_API int xlua_rawget_structs(lua_State *L, int idx, int type_id, int size, int len) {
+	int i;
+	CSharpStruct *buff;
+	idx = lua_absindex(L, idx);
+	buff = (CSharpStruct *)xlua_pushstructbuffer(L, (unsigned int)(size * len));
+	for (i = 0; i < len; i++) {
+		CSharpStruct *css;
+		lua_rawgeti(L, idx, i + 1);
+		/* an object of the type is a 4 bytes index userdata with the same metatable, so the size of the userdata is
+		   checked before its header is read */
+		if (type_id < 0 || lua_type(L, -1) != LUA_TUSERDATA || xlua_gettypeid(L, -1) != type_id
+			|| xlua_objlen(L, -1) < size + sizeof(int) + sizeof(unsigned int)) {
+			lua_pop(L, 1);
+			return i;
+		}
+		css = (CSharpStruct *)lua_touserdata(L, -1);
+		if (css->fake_id != -1 || css->len != (unsigned int)size) {
+			lua_pop(L, 1);
+			return i;
+		}
+		memcpy(buff->data + i * size, css->data, size);
+		lua_pop(L, 1);
+	}
+	return len;
+}
+
+/* compact encoding of the argument types from position "from" on, used to cache overload resolution. 
+   returns -1 if there are more than len arguments or one of them has no type id */
+LUA_API int xlua_getargshape(lua_State *L, int from, int *buff, int len) {
+	int i, type, type_id;
+	int n = lua_gettop(L) - from + 1;
+	if (n > len) {
+		return -1;
+	}
+	for (i = 0; i < n; i++) {
+		type = lua_type(L, from + i);
+		if (type == LUA_TUSERDATA) {
+			type_id = xlua_gettypeid(L, from + i);
+			if (type_id < 0) {
+				return -1;
+			}
+			buff[i] = (type_id << 4) | LUA_TUSERDATA;
+#if LUA_VERSION_NUM >= 503
+		} else if (type == LUA_TNUMBER && lua_isinteger(L, from + i)) {
+			buff[i] = 0xF;
+#endif
+		} else {
+			buff[i] = type;
+		}
+	}
+	return n;
+}
+
 #define PACK_UNPACK_OF(type) \
 LUALIB_API int xlua_pack_##type(void *p, int offset, type field) {\
 	CSharpStruct *css = (CSharpStruct *)p;\
@@ -1171,10 +1612,106 @@ static const lua_CFunction direct_setters[10] = {
 	xlua_struct_set_double
 };
 
+/* byte position of field offset in element i (1-based) of a strided buffer, i is range checked first so
+   the arithmetic is done in size_t and cannot overflow */
+static int strided_pos(CSharpStruct *css, int i, int stride, int offset, size_t size, size_t *pos) {
+	size_t left;
+	if (css == NULL || css->fake_id != -1 || i < 1 || (size_t)(i - 1) >= css->len / (size_t)stride) {
+		return 0;
+	}
+	*pos = (size_t)(i - 1) * (size_t)stride;
+	left = css->len - *pos;
+	if ((size_t)offset > left || size > left - (size_t)offset) {
+		return 0;
+	}
+	*pos += (size_t)offset;
+	return 1;
+}
+
+#define STRIDED_ACCESS(type, push_func, to_func) \
+int xlua_struct_array_get_##type(lua_State *L) {\
+	CSharpStruct *css = (CSharpStruct *)lua_touserdata(L, 1);\
+	int offset = xlua_tointeger(L, lua_upvalueindex(1));\
+	int stride = xlua_tointeger(L, lua_upvalueindex(2));\
+	int i = xlua_tointeger(L, 2);\
+	type val;\
+	size_t pos;\
+	if (!strided_pos(css, i, stride, offset, sizeof(type), &pos)) {\
+		return luaL_error(L, "invalid c# struct buffer or index out of range!");\
+	} else {\
+		memcpy(&val, (&(css->data[0]) + pos), sizeof(type));\
+		push_func(L, val);\
+		return 1;\
+	}\
+}\
+\
+int xlua_struct_array_set_##type(lua_State *L) { \
+	CSharpStruct *css = (CSharpStruct *)lua_touserdata(L, 1);\
+	int offset = xlua_tointeger(L, lua_upvalueindex(1));\
+	int stride = xlua_tointeger(L, lua_upvalueindex(2));\
+	int i = xlua_tointeger(L, 2);\
+	type val;\
+	size_t pos;\
+	if (!strided_pos(css, i, stride, offset, sizeof(type), &pos)) {\
+		return luaL_error(L, "invalid c# struct buffer or index out of range!");\
+	} else {\
+	    val = (type)to_func(L, 3);\
+		memcpy((&(css->data[0]) + pos), &val, sizeof(type));\
+		return 0;\
+	}\
+}\
+
+STRIDED_ACCESS(int8_t, xlua_pushinteger, xlua_tointeger);
+STRIDED_ACCESS(uint8_t, xlua_pushinteger, xlua_tointeger);
+STRIDED_ACCESS(int16_t, xlua_pushinteger, xlua_tointeger);
+STRIDED_ACCESS(uint16_t, xlua_pushinteger, xlua_tointeger);
+STRIDED_ACCESS(int32_t, xlua_pushinteger, xlua_tointeger);
+STRIDED_ACCESS(uint32_t, xlua_pushuint, xlua_touint);
+STRIDED_ACCESS(int64_t, lua_pushint64, lua_toint64);
+STRIDED_ACCESS(uint64_t, lua_pushuint64, lua_touint64);
+STRIDED_ACCESS(float, lua_pushnumber, lua_tonumber);
+STRIDED_ACCESS(double, lua_pushnumber, lua_tonumber);
+
+static const lua_CFunction strided_getters[10] = {
+	xlua_struct_array_get_int8_t,
+	xlua_struct_array_get_uint8_t,
+	xlua_struct_array_get_int16_t,
+	xlua_struct_array_get_uint16_t,
+	xlua_struct_array_get_int32_t,
+	xlua_struct_array_get_uint32_t,
+	xlua_struct_array_get_int64_t,
+	xlua_struct_array_get_uint64_t,
+	xlua_struct_array_get_float,
+	xlua_struct_array_get_double
+};
+
+static const lua_CFunction strided_setters[10] = {
+	xlua_struct_array_set_int8_t,
+	xlua_struct_array_set_uint8_t,
+	xlua_struct_array_set_int16_t,
+	xlua_struct_array_set_uint16_t,
+	xlua_struct_array_set_int32_t,
+	xlua_struct_array_set_uint32_t,
+	xlua_struct_array_set_int64_t,
+	xlua_struct_array_set_uint64_t,
+	xlua_struct_array_set_float,
+	xlua_struct_array_set_double
+};
+
 int nop(lua_State *L) {
 	return 0;
 }
 
+static int struct_array_count(lua_State *L) {
+	CSharpStruct *css = (CSharpStruct *)lua_touserdata(L, 1);
+	int stride = xlua_tointeger(L, lua_upvalueindex(1));
+	if (css == NULL || css->fake_id != -1) {
+		return luaL_error(L, "invalid c# struct buffer!");
+	}
+	lua_pushinteger(L, css->len / stride);
+	return 1;
+}
+
 LUA_API int gen_css_access(lua_State *L) {
 	int offset = xlua_tointeger(L, 1);
 	int type = xlua_tointeger(L, 2);
@@ -1192,6 +1729,30 @@ LUA_API int gen_css_access(lua_State *L) {
 	return 3;
 }
 
+LUA_API int gen_css_array_access(lua_State *L) {
+	int offset = xlua_tointeger(L, 1);
+	int type = xlua_tointeger(L, 2);
+	int stride = xlua_tointeger(L, 3);
+	if (offset < 0) {
+		return luaL_error(L, "offset must larger than 0");
+	}
+	if (type < T_INT8 || type > T_DOUBLE) {
+		return luaL_error(L, "unknow tag[%d]", type);
+	}
+	if (stride <= 0) {
+		return luaL_error(L, "stride must larger than 0");
+	}
+	lua_pushvalue(L, 1);
+	lua_pushvalue(L, 3);
+	lua_pushcclosure(L, strided_getters[type], 2);
+	lua_pushvalue(L, 1);
+	lua_pushvalue(L, 3);
+	lua_pushcclosure(L, strided_setters[type], 2);
+	lua_pushvalue(L, 3);
+	lua_pushcclosure(L, struct_array_count, 1);
+	return 3;
+}
+
 static int is_cs_data(lua_State *L, int idx) {
 	if (LUA_TUSERDATA == lua_type(L, idx) && lua_getmetatable(L, idx)) {
 		lua_pushlightuserdata(L, &tag);
@@ -1225,14 +1786,56 @@ LUA_API void* xlua_gl(lua_State *L) {
 	return G(L);
 }
 
+/* index of the c# ObjectTranslator owning a lua state, lets the managed side find it without a lookup keyed by global_State.
+ * 5.3 keeps it in the extra space of the main thread, which every coroutine copies at creation,
+ * otherwise a small table of global_State is scanned. */
+#ifdef LUA_EXTRASPACE
+LUA_API int xlua_settranslatorindex(lua_State *L, int index) {
+	*((intptr_t *)lua_getextraspace(L)) = index + 1;
+	return 1;
+}
+
+LUA_API int xlua_gettranslatorindex(lua_State *L) {
+	return (int)(*((intptr_t *)lua_getextraspace(L))) - 1;
+}
+#else
+#define XLUA_MAX_TRANSLATOR_INDEX 64
+static void *translator_gl[XLUA_MAX_TRANSLATOR_INDEX];
+
+LUA_API int xlua_settranslatorindex(lua_State *L, int index) {
+	int i;
+	void *gl = G(L);
+	for (i = 0; i < XLUA_MAX_TRANSLATOR_INDEX; i++) {
+		if (translator_gl[i] == gl) translator_gl[i] = NULL;
+	}
+	if (index < 0) return 1;
+	if (index >= XLUA_MAX_TRANSLATOR_INDEX) return 0;
+	translator_gl[index] = gl;
+	return 1;
+}
+
+LUA_API int xlua_gettranslatorindex(lua_State *L) {
+	int i;
+	void *gl = G(L);
+	for (i = 0; i < XLUA_MAX_TRANSLATOR_INDEX; i++) {
+		if (translator_gl[i] == gl) return i;
+	}
+	return -1;
+}
+#endif
+
 static const luaL_Reg xlualib[] = {
 	{"sethook", profiler_set_hook},
 	{"genaccessor", gen_css_access},
+	{"genarrayaccessor", gen_css_array_access},
 	{"structclone", css_clone},
 	{NULL, NULL}
 };
 
 LUA_API void luaopen_xlua(lua_State *L) {
+#ifdef LUA_EXTRASPACE
+	xlua_settranslatorindex(L, -1);
+#endif
 	luaL_openlibs(L);
 	
 #if LUA_VERSION_NUM == 503